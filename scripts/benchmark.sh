@@ -120,6 +120,11 @@ done
 # Clean up timing files
 rm -f build/tmp/published_times.txt build/tmp/local_times.txt
 
+echo "Step 4: Counting heap allocations on the domain extraction path..."
+${CXX:-c++} -std=c++17 -O2 -Isrc benchmark/domain_allocations.cpp src/utils/tld_lookup.cpp -o build/tmp/domain_allocations
+echo "" >> build/benchmark_results/analysis.txt
+./build/tmp/domain_allocations >> build/benchmark_results/analysis.txt
+
 echo ""
 echo "✅ Benchmark comparison complete!"
 echo ""
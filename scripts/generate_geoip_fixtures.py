@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+"""Write the small MaxMind DB files used by test/sql/geoip_lookup.test.
+
+The databases follow the MaxMind DB format 2.0 (https://maxmind.github.io/MaxMind-DB/) and hold a handful of
+made-up records. Run from the repository root: python3 scripts/generate_geoip_fixtures.py
+"""
+
+import ipaddress
+import struct
+
+METADATA_MARKER = b"\xab\xcd\xefMaxMind.com"
+
+POINTER, STRING, DOUBLE, UINT16, UINT32, MAP, UINT64, ARRAY, BOOLEAN = 1, 2, 3, 5, 6, 7, 9, 11, 14
+
+
+def control(kind, size):
+    if kind <= 7:
+        first, extended = kind << 5, b""
+    else:
+        first, extended = 0, bytes([kind - 7])
+    if size < 29:
+        return bytes([first | size]) + extended
+    if size < 285:
+        return bytes([first | 29]) + extended + bytes([size - 29])
+    if size < 65821:
+        return bytes([first | 30]) + extended + (size - 285).to_bytes(2, "big")
+    return bytes([first | 31]) + extended + (size - 65821).to_bytes(3, "big")
+
+
+class DataWriter:
+    """Encodes values into a data section. Repeated map keys are written once and then referenced by pointers."""
+
+    def __init__(self):
+        self.data = bytearray()
+        self.keys = {}
+
+    def write(self, raw):
+        self.data += raw
+
+    def unsigned(self, kind, value):
+        raw = value.to_bytes((value.bit_length() + 7) // 8, "big")
+        self.write(control(kind, len(raw)) + raw)
+
+    def encode(self, value):
+        if isinstance(value, bool):
+            self.write(control(BOOLEAN, int(value)))
+        elif isinstance(value, str):
+            raw = value.encode()
+            self.write(control(STRING, len(raw)) + raw)
+        elif isinstance(value, float):
+            self.write(control(DOUBLE, 8) + struct.pack(">d", value))
+        elif isinstance(value, int):
+            self.unsigned(UINT32, value)
+        elif isinstance(value, tuple):
+            self.unsigned(*value)
+        elif isinstance(value, list):
+            self.write(control(ARRAY, len(value)))
+            for item in value:
+                self.encode(item)
+        else:
+            self.write(control(MAP, len(value)))
+            for key, item in value.items():
+                self.key(key)
+                self.encode(item)
+
+    def key(self, key):
+        offset = self.keys.get(key)
+        if offset is not None:
+            self.write(bytes([(POINTER << 5) | (offset >> 8), offset & 0xFF]))
+            return
+        if len(self.data) < 2048:
+            self.keys[key] = len(self.data)
+        self.encode(key)
+
+    def add(self, value):
+        offset = len(self.data)
+        self.encode(value)
+        return offset
+
+
+def build(path, ip_version, record_size, database_type, networks):
+    # Binary trie of the networks, a node is [left, right] and a leaf is the offset of its record
+    root = [None, None]
+    writer = DataWriter()
+    for network, record in networks:
+        network = ipaddress.ip_network(network)
+        address = int(network.network_address)
+        bits = network.prefixlen
+        if ip_version == 6 and network.version == 4:
+            # IPv4 networks live in ::/96
+            bits += 96
+        total = 128 if ip_version == 6 else 32
+        offset = writer.add(record)
+        node = root
+        for i in range(bits - 1):
+            bit = (address >> (total - 1 - i)) & 1
+            if not isinstance(node[bit], list):
+                node[bit] = [node[bit], node[bit]]
+            node = node[bit]
+        node[(address >> (total - bits)) & 1] = ("data", offset)
+
+    nodes = []
+    queue = [root]
+    while queue:
+        node = queue.pop(0)
+        nodes.append(node)
+        queue.extend(child for child in node if isinstance(child, list))
+    numbers = {id(node): number for number, node in enumerate(nodes)}
+    node_count = len(nodes)
+
+    def record_value(child):
+        if child is None:
+            return node_count
+        if isinstance(child, list):
+            return numbers[id(child)]
+        return node_count + 16 + child[1]
+
+    tree = bytearray()
+    for node in nodes:
+        left, right = record_value(node[0]), record_value(node[1])
+        if record_size == 24:
+            tree += left.to_bytes(3, "big") + right.to_bytes(3, "big")
+        elif record_size == 28:
+            middle = ((left >> 24) << 4) | (right >> 24)
+            tree += (left & 0xFFFFFF).to_bytes(3, "big") + bytes([middle]) + (right & 0xFFFFFF).to_bytes(3, "big")
+        else:
+            tree += left.to_bytes(4, "big") + right.to_bytes(4, "big")
+
+    metadata = DataWriter()
+    metadata.encode(
+        {
+            "binary_format_major_version": (UINT16, 2),
+            "binary_format_minor_version": (UINT16, 0),
+            "build_epoch": (UINT64, 1760659200),
+            "database_type": database_type,
+            "description": {"en": "netquack test fixture"},
+            "ip_version": (UINT16, ip_version),
+            "languages": ["en"],
+            "node_count": node_count,
+            "record_size": (UINT16, record_size),
+        }
+    )
+    with open(path, "wb") as output:
+        output.write(tree + bytes(16) + writer.data + METADATA_MARKER + metadata.data)
+
+
+CITY = [
+    (
+        "1.2.3.0/24",
+        {
+            "city": {"geoname_id": 2147714, "names": {"de": "Sydney", "en": "Sydney"}},
+            "country": {"geoname_id": 2077456, "iso_code": "AU", "names": {"en": "Australia"}},
+            "location": {"latitude": -33.8688, "longitude": 151.209},
+        },
+    ),
+    (
+        "81.2.69.0/24",
+        {
+            "city": {"names": {"en": "London", "fr": "Londres"}},
+            "continent": {"code": "EU"},
+            "country": {"iso_code": "GB", "names": {"en": "United Kingdom"}},
+            "subdivisions": [{"iso_code": "ENG"}, {"iso_code": "LND"}],
+        },
+    ),
+    ("81.2.70.0/23", {"country": {"iso_code": "GB"}, "traits": {"is_anycast": True}}),
+    ("2001:db8:100::/40", {"city": {"names": {"en": "Berlin"}}, "country": {"iso_code": "DE"}}),
+]
+
+ASN = [
+    ("1.1.1.0/24", {"autonomous_system_number": 13335, "autonomous_system_organization": "CLOUDFLARENET"}),
+    ("8.8.8.0/24", {"autonomous_system_number": 15169, "autonomous_system_organization": "GOOGLE"}),
+    ("81.2.69.0/24", {"autonomous_system_number": 20712, "autonomous_system_organization": "Andrews & Arnold"}),
+]
+
+if __name__ == "__main__":
+    build("test/data/geoip_city.mmdb", 6, 28, "GeoLite2-City", CITY)
+    build("test/data/geoip_asn.mmdb", 4, 24, "GeoLite2-ASN", ASN)
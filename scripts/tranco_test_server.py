@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+"""Run a command next to a local stand-in for the Tranco download server, for test/sql/update_tranco_http.test.
+
+The server listens on a free port of 127.0.0.1 and its address is passed to the command in
+NETQUACK_TRANCO_TEST_SERVER. It answers:
+
+  /tranco.csv    test/data/tranco.csv
+  /missing.csv   a 404 error page that looks like a list
+  /truncated.csv the first half of test/data/tranco.csv, then the connection is closed before the announced length
+
+Run from the repository root, e.g.: python3 scripts/tranco_test_server.py make test
+"""
+
+import os
+import subprocess
+import sys
+import threading
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+LIST_PATH = os.path.join("test", "data", "tranco.csv")
+
+
+class TrancoHandler(BaseHTTPRequestHandler):
+    def do_GET(self):
+        with open(LIST_PATH, "rb") as list_file:
+            body = list_file.read()
+        if self.path == "/tranco.csv":
+            self.send_body(200, body, len(body))
+        elif self.path == "/truncated.csv":
+            # The body ends in the middle of a line and short of its Content-Length
+            self.send_body(200, body[: len(body) // 2 + 3], len(body))
+            self.close_connection = True
+        else:
+            # An error page that would parse as a list of one domain
+            page = b"1,not-found.example\n"
+            self.send_body(404, page, len(page))
+
+    def send_body(self, status, body, length):
+        self.send_response(status)
+        self.send_header("Content-Type", "text/csv")
+        self.send_header("Content-Length", str(length))
+        self.end_headers()
+        self.wfile.write(body)
+        self.wfile.flush()
+
+    def log_message(self, format, *args):
+        pass
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit("usage: tranco_test_server.py COMMAND [ARGS...]")
+    server = ThreadingHTTPServer(("127.0.0.1", 0), TrancoHandler)
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+    env = dict(os.environ, NETQUACK_TRANCO_TEST_SERVER="http://127.0.0.1:%d" % server.server_address[1])
+    try:
+        status = subprocess.call(sys.argv[1:], env=env)
+    finally:
+        server.shutdown()
+    sys.exit(status)
+
+
+if __name__ == "__main__":
+    main()
@@ -4,6 +4,9 @@
 
 #include <array>
 
+#include "../utils/parse_failures.hpp"
+#include "../utils/vector_helpers.hpp"
+
 namespace duckdb {
 
 // Base64 alphabet
@@ -25,49 +28,28 @@ static constexpr std::array<uint8_t, 256> BuildBase64DecodeTable() {
 static constexpr auto BASE64_DECODE_TABLE = BuildBase64DecodeTable();
 
 void Base64EncodeFunction(DataChunk &args, ExpressionState &, Vector &result) {
-	const auto &input_vector = args.data[0];
-	auto result_data = FlatVector::GetData<string_t>(result);
-	auto &result_validity = FlatVector::Validity(result);
-
-	for (idx_t i = 0; i < args.size(); i++) {
-		auto value = input_vector.GetValue(i);
-		if (value.IsNull()) {
-			result_validity.SetInvalid(i);
-			continue;
-		}
-
-		auto input = value.ToString();
+	auto &input_vector = args.data[0];
 
-		try {
-			auto encoded = netquack::Base64Encode(input);
-			result_data[i] = StringVector::AddString(result, encoded);
-		} catch (const std::exception &e) {
-			result_data[i] = StringVector::AddString(result, "Error encoding base64: " + std::string(e.what()));
-		}
-	}
+	netquack::ExecuteUnary<string_t, string_t>(input_vector, result, args.size(), [&](string_t value, Vector &target) {
+		auto encoded = netquack::Base64Encode(std::string_view(value.GetData(), value.GetSize()));
+		return StringVector::AddString(target, encoded);
+	});
 }
 
-void Base64DecodeFunction(DataChunk &args, ExpressionState &, Vector &result) {
-	const auto &input_vector = args.data[0];
-	auto result_data = FlatVector::GetData<string_t>(result);
-	auto &result_validity = FlatVector::Validity(result);
-
-	for (idx_t i = 0; i < args.size(); i++) {
-		auto value = input_vector.GetValue(i);
-		if (value.IsNull()) {
-			result_validity.SetInvalid(i);
-			continue;
-		}
-
-		auto input = value.ToString();
-
-		try {
-			auto decoded = netquack::Base64Decode(input);
-			result_data[i] = StringVector::AddString(result, decoded);
-		} catch (const std::exception &e) {
-			result_data[i] = StringVector::AddString(result, "Error decoding base64: " + std::string(e.what()));
-		}
-	}
+void Base64DecodeFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &input_vector = args.data[0];
+	netquack::ParseFailures failures(state, "base64_decode");
+
+	netquack::ExecuteUnaryWithNulls<string_t, string_t>(
+	    input_vector, result, args.size(), [&](string_t value, ValidityMask &mask, idx_t idx, Vector &target) {
+		    auto decoded = netquack::Base64Decode(std::string_view(value.GetData(), value.GetSize()));
+		    if (!decoded) {
+			    // Without `netquack_null_on_error` malformed input keeps its historical marker
+			    return failures.fail(mask, idx) ? string_t() : string_t("INVALID_BASE64");
+		    }
+		    return StringVector::AddString(target, *decoded);
+	    },
+	    &failures);
 }
 
 namespace netquack {
@@ -101,7 +83,7 @@ std::string Base64Encode(const std::string_view &input) {
 	return result;
 }
 
-std::string Base64Decode(const std::string_view &input) {
+std::optional<std::string> Base64Decode(const std::string_view &input) {
 	if (input.empty()) {
 		return "";
 	}
@@ -121,7 +103,7 @@ std::string Base64Decode(const std::string_view &input) {
 
 	// Validate length (must be multiple of 4 for standard base64)
 	if (cleaned.size() % 4 != 0) {
-		return "INVALID_BASE64";
+		return std::nullopt;
 	}
 
 	// Validate characters
@@ -130,10 +112,10 @@ std::string Base64Decode(const std::string_view &input) {
 		if (c == '=') {
 			// Padding only allowed at the end (last 1-2 chars)
 			if (i < cleaned.size() - 2) {
-				return "INVALID_BASE64";
+				return std::nullopt;
 			}
 		} else if (BASE64_DECODE_TABLE[static_cast<uint8_t>(c)] == 255) {
-			return "INVALID_BASE64";
+			return std::nullopt;
 		}
 	}
 
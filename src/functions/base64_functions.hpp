@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include "duckdb.hpp"
 
 namespace duckdb {
@@ -15,7 +17,7 @@ namespace netquack {
 // Encode a string to Base64
 std::string Base64Encode(const std::string_view &input);
 
-// Decode a Base64 string
-std::string Base64Decode(const std::string_view &input);
+// Decode a Base64 string, std::nullopt if it is not valid Base64
+std::optional<std::string> Base64Decode(const std::string_view &input);
 } // namespace netquack
 } // namespace duckdb
@@ -0,0 +1,51 @@
+// Copyright 2026 Arash Hatami
+
+#include "domain_cache_stats.hpp"
+
+#include "../utils/domain_cache.hpp"
+
+namespace duckdb::netquack {
+struct DomainCacheStatsLocalState : public LocalTableFunctionState {
+	std::atomic_bool done {false};
+};
+
+unique_ptr<FunctionData> DomainCacheStatsFunc::Bind(ClientContext &, TableFunctionBindInput &,
+                                                    vector<LogicalType> &return_types, vector<string> &names) {
+	// 0. hits: lookups answered from a cache
+	return_types.emplace_back(LogicalTypeId::UBIGINT);
+	names.emplace_back("hits");
+	// 1. misses: lookups that walked the public suffix list
+	return_types.emplace_back(LogicalTypeId::UBIGINT);
+	names.emplace_back("misses");
+	// 2. hit_rate: hits / (hits + misses), NULL before the first lookup
+	return_types.emplace_back(LogicalTypeId::DOUBLE);
+	names.emplace_back("hit_rate");
+	return make_uniq<TableFunctionData>();
+}
+
+unique_ptr<LocalTableFunctionState> DomainCacheStatsFunc::InitLocal(ExecutionContext &, TableFunctionInitInput &,
+                                                                    GlobalTableFunctionState *) {
+	return make_uniq<DomainCacheStatsLocalState>();
+}
+
+unique_ptr<GlobalTableFunctionState> DomainCacheStatsFunc::InitGlobal(ClientContext &, TableFunctionInitInput &) {
+	return nullptr;
+}
+
+void DomainCacheStatsFunc::Scan(ClientContext &, TableFunctionInput &data_p, DataChunk &output) {
+	auto &local_state = dynamic_cast<DomainCacheStatsLocalState &>(*data_p.local_state);
+	if (local_state.done) {
+		return;
+	}
+
+	auto statistics = DomainCache::statistics();
+	auto lookups = statistics.hits + statistics.misses;
+
+	output.SetCardinality(1);
+	output.data[0].SetValue(0, Value::UBIGINT(statistics.hits));
+	output.data[1].SetValue(0, Value::UBIGINT(statistics.misses));
+	output.data[2].SetValue(0, lookups ? Value::DOUBLE(static_cast<double>(statistics.hits) / lookups)
+	                                   : Value(LogicalType::DOUBLE));
+	local_state.done = true;
+}
+} // namespace duckdb::netquack
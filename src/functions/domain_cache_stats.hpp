@@ -0,0 +1,17 @@
+// Copyright 2026 Arash Hatami
+
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb::netquack {
+// Table function reporting the hit rate of the per-thread host -> domain caches
+struct DomainCacheStatsFunc {
+	static unique_ptr<FunctionData> Bind(ClientContext &context, TableFunctionBindInput &input,
+	                                     vector<LogicalType> &return_types, vector<string> &names);
+	static void Scan(ClientContext &context, TableFunctionInput &data_p, DataChunk &output);
+	static unique_ptr<LocalTableFunctionState> InitLocal(ExecutionContext &context, TableFunctionInitInput &input,
+	                                                     GlobalTableFunctionState *global_state_p);
+	static unique_ptr<GlobalTableFunctionState> InitGlobal(ClientContext &context, TableFunctionInitInput &input);
+};
+} // namespace duckdb::netquack
@@ -3,73 +3,44 @@
 #include "domain_depth.hpp"
 
 #include "../utils/url_helpers.hpp"
+#include "../utils/vector_helpers.hpp"
 
 namespace duckdb {
 void DomainDepthFunction(DataChunk &args, ExpressionState &, Vector &result) {
-	const auto &input_vector = args.data[0];
-	auto result_data = FlatVector::GetData<int32_t>(result);
-	auto &result_validity = FlatVector::Validity(result);
-
-	for (idx_t i = 0; i < args.size(); i++) {
-		auto value = input_vector.GetValue(i);
-		if (value.IsNull()) {
-			result_validity.SetInvalid(i);
-			continue;
-		}
-
-		auto input = value.ToString();
+	auto &input_vector = args.data[0];
 
-		try {
-			result_data[i] = netquack::DomainDepth(input);
-		} catch (const std::exception &) {
-			result_data[i] = 0;
-		}
-	}
+	netquack::ExecuteUnary<string_t, int32_t>(input_vector, result, args.size(), [&](string_t value, Vector &) {
+		return netquack::DomainDepth(std::string_view(value.GetData(), value.GetSize()));
+	});
 }
 
 namespace netquack {
-int32_t DomainDepth(const std::string &input) {
+int32_t DomainDepth(const std::string_view &input) {
 	if (input.empty()) {
 		return 0;
 	}
 
-	// Lowercase the input for consistent host extraction
-	std::string lowered = input;
-	std::transform(lowered.begin(), lowered.end(), lowered.begin(), ::tolower);
-
-	// Extract the host from the URL using the existing utility
-	const char *data = lowered.data();
-	size_t size = lowered.size();
+	// Extract the host from the URL using the existing utility. Host extraction and the checks
+	// below are case-insensitive, so the input is not lower-cased.
+	const char *data = input.data();
+	size_t size = input.size();
 	std::string_view host = getURLHost(data, size);
 
 	// If no host could be extracted, treat the whole input as a potential bare domain
-	std::string host_str;
 	if (host.empty()) {
 		// If the input has a scheme (://), there's no valid host — return 0
-		if (lowered.find("://") != std::string::npos) {
+		if (input.find("://") != std::string_view::npos) {
 			return 0;
 		}
 
 		// Strip any path/query/fragment from bare domain input
-		std::string bare = lowered;
-		auto slash_pos = bare.find('/');
-		if (slash_pos != std::string::npos) {
-			bare = bare.substr(0, slash_pos);
-		}
-		auto question_pos = bare.find('?');
-		if (question_pos != std::string::npos) {
-			bare = bare.substr(0, question_pos);
-		}
-		auto hash_pos = bare.find('#');
-		if (hash_pos != std::string::npos) {
-			bare = bare.substr(0, hash_pos);
-		}
+		std::string_view bare = input.substr(0, find_first_symbols<'/', '?', '#'>(data, data + size) - data);
 		// Strip port
 		auto colon_pos = bare.rfind(':');
-		if (colon_pos != std::string::npos) {
+		if (colon_pos != std::string_view::npos) {
 			bool all_digits = true;
 			for (size_t k = colon_pos + 1; k < bare.size(); ++k) {
-				if (!std::isdigit(static_cast<unsigned char>(bare[k]))) {
+				if (!isNumericASCII(bare[k])) {
 					all_digits = false;
 					break;
 				}
@@ -97,33 +68,27 @@ int32_t DomainDepth(const std::string &input) {
 			// Single label like "localhost" — depth is 1
 			// But only if it looks reasonable (alphanumeric + hyphens)
 			for (char c : bare) {
-				if (std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_') {
+				if (isAlphaNumericASCII(c) || c == '-' || c == '_') {
 					continue;
 				}
 				return 0;
 			}
 			return 1;
 		}
-		host_str = bare;
-	} else {
-		host_str = std::string(host);
-	}
-
-	if (host_str.empty()) {
-		return 0;
+		host = bare;
 	}
 
 	// Remove trailing dot if present (DNS canonical form)
-	if (!host_str.empty() && host_str.back() == '.') {
-		host_str.pop_back();
+	if (!host.empty() && host.back() == '.') {
+		host.remove_suffix(1);
 	}
 
-	if (host_str.empty()) {
+	if (host.empty()) {
 		return 0;
 	}
 
 	// Skip IPv6 addresses (e.g., [::1]) — they have no domain depth
-	if (host_str.front() == '[') {
+	if (host.front() == '[') {
 		return 0;
 	}
 
@@ -132,14 +97,14 @@ int32_t DomainDepth(const std::string &input) {
 		bool all_numeric_parts = true;
 		size_t part_start = 0;
 		int dot_count = 0;
-		for (size_t j = 0; j <= host_str.size(); ++j) {
-			if (j == host_str.size() || host_str[j] == '.') {
+		for (size_t j = 0; j <= host.size(); ++j) {
+			if (j == host.size() || host[j] == '.') {
 				if (j == part_start) {
 					all_numeric_parts = false;
 					break;
 				}
 				for (size_t k = part_start; k < j; ++k) {
-					if (!std::isdigit(static_cast<unsigned char>(host_str[k]))) {
+					if (!isNumericASCII(host[k])) {
 						all_numeric_parts = false;
 						break;
 					}
@@ -147,7 +112,7 @@ int32_t DomainDepth(const std::string &input) {
 				if (!all_numeric_parts) {
 					break;
 				}
-				if (host_str[j] == '.') {
+				if (j < host.size()) {
 					++dot_count;
 				}
 				part_start = j + 1;
@@ -160,7 +125,7 @@ int32_t DomainDepth(const std::string &input) {
 
 	// Count dot-separated levels
 	int32_t depth = 1;
-	for (char c : host_str) {
+	for (char c : host) {
 		if (c == '.') {
 			++depth;
 		}
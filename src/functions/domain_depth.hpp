@@ -10,6 +10,6 @@ void DomainDepthFunction(DataChunk &args, ExpressionState &state, Vector &result
 
 namespace netquack {
 // Return the number of dot-separated levels in a domain/host
-int32_t DomainDepth(const std::string &input);
+int32_t DomainDepth(const std::string_view &input);
 } // namespace netquack
 } // namespace duckdb
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include "duckdb/common/types/data_chunk.hpp"
 #include "duckdb/common/types/vector.hpp"
 #include "duckdb/execution/expression_executor.hpp"
@@ -10,7 +12,9 @@ namespace duckdb {
 void ExtractDomainFunction(DataChunk &args, ExpressionState &state, Vector &result);
 
 namespace netquack {
-// Function to extract the main domain from a URL
-std::string ExtractDomain(const std::string &input);
+class DomainCache;
+
+// Function to extract the main domain from a URL, std::nullopt if the input has no host
+std::optional<std::string_view> ExtractDomain(const std::string_view &input, DomainCache &domain_cache);
 } // namespace netquack
 } // namespace duckdb
@@ -3,34 +3,21 @@
 #include "extract_extension.hpp"
 
 #include "../utils/url_helpers.hpp"
+#include "../utils/vector_helpers.hpp"
 
 namespace duckdb {
 void ExtractExtensionFunction(DataChunk &args, ExpressionState &, Vector &result) {
-	const auto &input_vector = args.data[0];
-	auto result_data = FlatVector::GetData<string_t>(result);
-	auto &result_validity = FlatVector::Validity(result);
-
-	for (idx_t i = 0; i < args.size(); i++) {
-		auto value = input_vector.GetValue(i);
-		if (value.IsNull()) {
-			result_validity.SetInvalid(i);
-			continue;
-		}
-
-		auto input = value.ToString();
-		std::transform(input.begin(), input.end(), input.begin(), ::tolower);
+	auto &input_vector = args.data[0];
 
-		try {
-			auto ext = netquack::ExtractExtension(input);
-			result_data[i] = StringVector::AddString(result, ext);
-		} catch (const std::exception &e) {
-			result_data[i] = StringVector::AddString(result, "Error extracting extension: " + std::string(e.what()));
-		}
-	}
+	netquack::ExecuteUnary<string_t, string_t>(input_vector, result, args.size(), [&](string_t value, Vector &target) {
+		// Parsing only looks at ASCII delimiters, so only the extension itself is folded to lower case
+		auto ext = netquack::ExtractExtension(std::string_view(value.GetData(), value.GetSize()));
+		return netquack::LowerStringSlice(target, ext);
+	});
 }
 
 namespace netquack {
-std::string ExtractExtension(const std::string_view &input) {
+std::string_view ExtractExtension(const std::string_view &input) {
 	if (input.empty()) {
 		return "";
 	}
@@ -89,7 +76,7 @@ std::string ExtractExtension(const std::string_view &input) {
 		}
 	}
 
-	return std::string(ext_start, ext_length);
+	return std::string_view(ext_start, ext_length);
 }
 } // namespace netquack
 } // namespace duckdb
@@ -3,35 +3,22 @@
 #include "extract_fragment.hpp"
 
 #include "../utils/url_helpers.hpp"
+#include "../utils/vector_helpers.hpp"
 
 namespace duckdb {
 void ExtractFragmentFunction(DataChunk &args, ExpressionState &, Vector &result) {
-	const auto &input_vector = args.data[0];
-	auto result_data = FlatVector::GetData<string_t>(result);
-	auto &result_validity = FlatVector::Validity(result);
-
-	for (idx_t i = 0; i < args.size(); i++) {
-		auto value = input_vector.GetValue(i);
-		if (value.IsNull()) {
-			result_validity.SetInvalid(i);
-			continue;
-		}
-
-		auto input = value.ToString();
-
-		try {
-			auto fragment = netquack::ExtractFragment(input);
-			result_data[i] = StringVector::AddString(result, fragment);
-		} catch (const std::exception &e) {
-			result_data[i] = StringVector::AddString(result, "Error extracting fragment: " + std::string(e.what()));
-		}
-	}
+	auto &input_vector = args.data[0];
+
+	netquack::ExecuteUnary<string_t, string_t>(input_vector, result, args.size(), [&](string_t input, Vector &) {
+		auto fragment = netquack::ExtractFragment(std::string_view(input.GetData(), input.GetSize()));
+		return netquack::StringSlice(fragment);
+	});
 }
 
 namespace netquack {
-std::string ExtractFragment(const std::string_view &input) {
+std::string_view ExtractFragment(const std::string_view &input) {
 	if (input.empty()) {
-		return "";
+		return {};
 	}
 
 	const char *data = input.data();
@@ -43,7 +30,7 @@ std::string ExtractFragment(const std::string_view &input) {
 	const char *hash_pos = find_first_symbols<'#'>(pos, end);
 	if (hash_pos == end) {
 		// No fragment found
-		return "";
+		return {};
 	}
 
 	// Skip the '#' character
@@ -52,10 +39,10 @@ std::string ExtractFragment(const std::string_view &input) {
 	// Everything after '#' is the fragment
 	size_t fragment_size = end - hash_pos;
 	if (fragment_size == 0) {
-		return "";
+		return {};
 	}
 
-	return std::string(hash_pos, fragment_size);
+	return std::string_view(hash_pos, fragment_size);
 }
 } // namespace netquack
 } // namespace duckdb
@@ -10,6 +10,6 @@ void ExtractHostFunction(DataChunk &args, ExpressionState &state, Vector &result
 
 namespace netquack {
 // Function to extract the host from a URL
-std::string ExtractHost(const std::string_view &input);
+std::string_view ExtractHost(const std::string_view &input);
 } // namespace netquack
 } // namespace duckdb
@@ -3,34 +3,20 @@
 #include "extract_path.hpp"
 
 #include "../utils/url_helpers.hpp"
+#include "../utils/vector_helpers.hpp"
 
 namespace duckdb {
 void ExtractPathFunction(DataChunk &args, ExpressionState &, Vector &result) {
-	const auto &input_vector = args.data[0];
-	auto result_data = FlatVector::GetData<string_t>(result);
-	auto &result_validity = FlatVector::Validity(result);
+	auto &input_vector = args.data[0];
 
-	for (idx_t i = 0; i < args.size(); i++) {
-		auto value = input_vector.GetValue(i);
-		if (value.IsNull()) {
-			result_validity.SetInvalid(i);
-			continue;
-		}
-
-		auto input = value.ToString();
-		std::transform(input.begin(), input.end(), input.begin(), ::tolower);
-
-		try {
-			auto path = netquack::ExtractPath(input);
-			result_data[i] = StringVector::AddString(result, path);
-		} catch (const std::exception &e) {
-			result_data[i] = StringVector::AddString(result, "Error extracting path: " + std::string(e.what()));
-		}
-	}
+	netquack::ExecuteUnary<string_t, string_t>(input_vector, result, args.size(), [&](string_t input, Vector &target) {
+		auto path = netquack::ExtractPath(std::string_view(input.GetData(), input.GetSize()));
+		return netquack::LowerStringSlice(target, path);
+	});
 }
 
 namespace netquack {
-std::string ExtractPath(const std::string_view &input) {
+std::string_view ExtractPath(const std::string_view &input) {
 	if (input.empty()) {
 		return "/";
 	}
@@ -67,7 +53,7 @@ std::string ExtractPath(const std::string_view &input) {
 		return "/";
 	}
 
-	return std::string(pos, path_size);
+	return std::string_view(pos, path_size);
 }
 } // namespace netquack
 } // namespace duckdb
@@ -2,35 +2,29 @@
 
 #include "extract_port.hpp"
 
+#include "../utils/parse_failures.hpp"
 #include "../utils/url_helpers.hpp"
+#include "../utils/vector_helpers.hpp"
 
 namespace duckdb {
-void ExtractPortFunction(DataChunk &args, ExpressionState &, Vector &result) {
-	const auto &input_vector = args.data[0];
-	auto result_data = FlatVector::GetData<string_t>(result);
-	auto &result_validity = FlatVector::Validity(result);
-
-	for (idx_t i = 0; i < args.size(); i++) {
-		auto value = input_vector.GetValue(i);
-		if (value.IsNull()) {
-			result_validity.SetInvalid(i);
-			continue;
-		}
-
-		auto input = value.ToString();
-		std::transform(input.begin(), input.end(), input.begin(), ::tolower);
-
-		try {
-			auto port = netquack::ExtractPort(input);
-			result_data[i] = StringVector::AddString(result, port);
-		} catch (const std::exception &e) {
-			result_data[i] = StringVector::AddString(result, "Error extracting port: " + std::string(e.what()));
-		}
-	}
+void ExtractPortFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &input_vector = args.data[0];
+	netquack::ParseFailures failures(state, "extract_port");
+
+	netquack::ExecuteUnaryWithNulls<string_t, string_t>(
+	    input_vector, result, args.size(), [&](string_t value, ValidityMask &mask, idx_t idx, Vector &) {
+		    auto port = netquack::ExtractPort(std::string_view(value.GetData(), value.GetSize()));
+		    if (!port) {
+			    failures.fail(mask, idx);
+			    return string_t();
+		    }
+		    return netquack::StringSlice(*port);
+	    },
+	    &failures);
 }
 
 namespace netquack {
-std::string ExtractPort(const std::string_view &input) {
+std::optional<std::string_view> ExtractPort(const std::string_view &input) {
 	if (input.empty()) {
 		return "";
 	}
@@ -112,20 +106,18 @@ std::string ExtractPort(const std::string_view &input) {
 		return "";
 	}
 
-	// Extract port digits
-	std::string port;
-	for (const char *p = port_start; p < end; ++p) {
-		if (*p == '/' || *p == '?' || *p == '#') {
+	// Extract port digits, anything else before the path makes the port malformed
+	const char *port_end = port_start;
+	for (; port_end < end; ++port_end) {
+		if (*port_end == '/' || *port_end == '?' || *port_end == '#') {
 			break;
 		}
-		if (!isNumericASCII(*p)) {
-			return "";
+		if (!isNumericASCII(*port_end)) {
+			return std::nullopt;
 		}
-
-		port += *p;
 	}
 
-	return port;
+	return std::string_view(port_start, port_end - port_start);
 }
 } // namespace netquack
 } // namespace duckdb
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include "duckdb.hpp"
 
 namespace duckdb {
@@ -9,7 +11,7 @@ namespace duckdb {
 void ExtractPortFunction(DataChunk &args, ExpressionState &state, Vector &result);
 
 namespace netquack {
-// Function to extract the port from a URL or host
-std::string ExtractPort(const std::string_view &input);
+// Function to extract the port from a URL or host, std::nullopt if the port is not numeric
+std::optional<std::string_view> ExtractPort(const std::string_view &input);
 } // namespace netquack
 } // namespace duckdb
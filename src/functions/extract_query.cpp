@@ -6,35 +6,22 @@
 #include <vector>
 
 #include "../utils/url_helpers.hpp"
+#include "../utils/vector_helpers.hpp"
 
 namespace duckdb {
 void ExtractQueryStringFunction(DataChunk &args, ExpressionState &, Vector &result) {
-	const auto &input_vector = args.data[0];
-	auto result_data = FlatVector::GetData<string_t>(result);
-	auto &result_validity = FlatVector::Validity(result);
-
-	for (idx_t i = 0; i < args.size(); i++) {
-		auto value = input_vector.GetValue(i);
-		if (value.IsNull()) {
-			result_validity.SetInvalid(i);
-			continue;
-		}
-
-		auto input = value.ToString();
+	auto &input_vector = args.data[0];
 
-		try {
-			auto query_string = netquack::ExtractQueryString(input);
-			result_data[i] = StringVector::AddString(result, query_string);
-		} catch (const std::exception &e) {
-			result_data[i] = StringVector::AddString(result, "Error extracting query string: " + std::string(e.what()));
-		}
-	}
+	netquack::ExecuteUnary<string_t, string_t>(input_vector, result, args.size(), [&](string_t input, Vector &) {
+		auto query_string = netquack::ExtractQueryString(std::string_view(input.GetData(), input.GetSize()));
+		return netquack::StringSlice(query_string);
+	});
 }
 
 namespace netquack {
-std::string ExtractQueryString(const std::string_view &input) {
+std::string_view ExtractQueryString(const std::string_view &input) {
 	if (input.empty()) {
-		return "";
+		return {};
 	}
 
 	const char *data = input.data();
@@ -45,7 +32,7 @@ std::string ExtractQueryString(const std::string_view &input) {
 	// Find the '?' character
 	const char *query_start = find_first_symbols<'?'>(pos, end);
 	if (query_start == end) {
-		return "";
+		return {};
 	}
 
 	// Find the fragment '#' character - must check from beginning
@@ -53,7 +40,7 @@ std::string ExtractQueryString(const std::string_view &input) {
 
 	// If '#' comes before '?', then '?' is part of fragment, not query
 	if (fragment < query_start) {
-		return "";
+		return {};
 	}
 
 	// Skip the '?' character
@@ -63,10 +50,10 @@ std::string ExtractQueryString(const std::string_view &input) {
 	const char *query_end = (fragment != end) ? fragment : end;
 	size_t query_size = query_end - query_start;
 	if (query_size == 0) {
-		return "";
+		return {};
 	}
 
-	return std::string(query_start, query_size);
+	return std::string_view(query_start, query_size);
 }
 
 // Parse query string into key-value pairs
@@ -182,7 +169,7 @@ OperatorResultType ExtractQueryParametersFunc::Function(ExecutionContext &, Tabl
 	}
 
 	auto url = url_value.GetValue<string>();
-	std::string query_string = ExtractQueryString(url);
+	auto query_string = ExtractQueryString(url);
 	local_state.parameters = ParseQueryParameters(query_string);
 	local_state.current_idx = 0;
 
@@ -2,77 +2,62 @@
 
 #include "extract_schema.hpp"
 
-#include <cstring>
+#include "../utils/url_helpers.hpp"
+#include "../utils/vector_helpers.hpp"
 
 namespace duckdb {
 void ExtractSchemaFunction(DataChunk &args, ExpressionState &, Vector &result) {
-	const auto &input_vector = args.data[0];
-	auto result_data = FlatVector::GetData<string_t>(result);
-	auto &result_validity = FlatVector::Validity(result);
+	auto &input_vector = args.data[0];
 
-	for (idx_t i = 0; i < args.size(); i++) {
-		auto value = input_vector.GetValue(i);
-		if (value.IsNull()) {
-			result_validity.SetInvalid(i);
-			continue;
-		}
-
-		auto input = value.ToString();
-		std::transform(input.begin(), input.end(), input.begin(), ::tolower);
-
-		try {
-			auto schema = netquack::ExtractSchema(input);
-			result_data[i] = StringVector::AddString(result, schema);
-		} catch (const std::exception &e) {
-			result_data[i] = StringVector::AddString(result, "Error extracting schema: " + std::string(e.what()));
-		}
-	}
+	netquack::ExecuteUnary<string_t, string_t>(input_vector, result, args.size(), [&](string_t input, Vector &) {
+		auto schema = netquack::ExtractSchema(std::string_view(input.GetData(), input.GetSize()));
+		return netquack::StringSlice(schema);
+	});
 }
 
 namespace netquack {
-std::string ExtractSchema(const std::string_view &input) {
+std::string_view ExtractSchema(const std::string_view &input) {
 	if (input.empty()) {
-		return "";
+		return {};
 	}
 
-	const char *data = input.data();
 	size_t size = input.size();
 
 	// Check for standard URL schemes with ://
-	if (size >= 7 && strncmp(data, "http://", 7) == 0) {
+	if (startsWithLowerCase(input, "http://")) {
 		return "http";
 	}
-	if (size >= 8 && strncmp(data, "https://", 8) == 0) {
+	if (startsWithLowerCase(input, "https://")) {
 		return "https";
 	}
-	if (size >= 6 && strncmp(data, "ftp://", 6) == 0) {
+	if (startsWithLowerCase(input, "ftp://")) {
 		return "ftp";
 	}
-	if (size >= 8 && strncmp(data, "rsync://", 8) == 0) {
+	if (startsWithLowerCase(input, "rsync://")) {
 		return "rsync";
 	}
 
 	// Check for schemes with : but no // (and ensure they're not followed by //)
-	if (size >= 7 && strncmp(data, "mailto:", 7) == 0) {
+	if (startsWithLowerCase(input, "mailto:")) {
 		// Reject mailto:// - only accept mailto: without //
-		if (size == 7 || (size > 7 && data[7] != '/')) {
+		if (size == 7 || (size > 7 && input[7] != '/')) {
 			return size > 7 ? "mailto" : ""; // Empty if just "mailto:"
 		}
 	}
-	if (size >= 4 && strncmp(data, "tel:", 4) == 0) {
+	if (startsWithLowerCase(input, "tel:")) {
 		// Reject tel:// - only accept tel: without //
-		if (size == 4 || (size > 4 && data[4] != '/')) {
+		if (size == 4 || (size > 4 && input[4] != '/')) {
 			return size > 4 ? "tel" : ""; // Empty if just "tel:"
 		}
 	}
-	if (size >= 4 && strncmp(data, "sms:", 4) == 0) {
+	if (startsWithLowerCase(input, "sms:")) {
 		// Reject sms:// - only accept sms: without //
-		if (size == 4 || (size > 4 && data[4] != '/')) {
+		if (size == 4 || (size > 4 && input[4] != '/')) {
 			return size > 4 ? "sms" : ""; // Empty if just "sms:"
 		}
 	}
 
-	return "";
+	return {};
 }
 } // namespace netquack
 } // namespace duckdb
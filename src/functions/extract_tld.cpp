@@ -2,38 +2,37 @@
 
 #include "extract_tld.hpp"
 
+#include "../utils/domain_cache.hpp"
+#include "../utils/parse_failures.hpp"
 #include "../utils/tld_lookup.hpp"
 #include "../utils/url_helpers.hpp"
+#include "../utils/vector_helpers.hpp"
 
 namespace duckdb {
-void ExtractTLDFunction(DataChunk &args, ExpressionState &, Vector &result) {
-	const auto &input_vector = args.data[0];
-	auto result_data = FlatVector::GetData<string_t>(result);
-	auto &result_validity = FlatVector::Validity(result);
-
-	for (idx_t i = 0; i < args.size(); i++) {
-		auto value = input_vector.GetValue(i);
-		if (value.IsNull()) {
-			result_validity.SetInvalid(i);
-			continue;
-		}
-
-		auto input = value.ToString();
-		std::transform(input.begin(), input.end(), input.begin(), ::tolower);
-
-		try {
-			auto tld = netquack::ExtractTLD(input);
-			result_data[i] = StringVector::AddString(result, tld);
-		} catch (const std::exception &e) {
-			result_data[i] = StringVector::AddString(result, "Error extracting tld: " + std::string(e.what()));
-		}
-	}
+void ExtractTLDFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &input_vector = args.data[0];
+	// Keep one list for the whole chunk, even if another one is installed meanwhile
+	auto suffix_list = netquack::PublicSuffixList::current();
+	auto &domain_cache = netquack::DomainCacheLocalState::GetCache(state, *suffix_list);
+
+	netquack::ParseFailures failures(state, "extract_tld");
+
+	netquack::ExecuteUnaryWithNulls<string_t, string_t>(
+	    input_vector, result, args.size(), [&](string_t value, ValidityMask &mask, idx_t idx, Vector &target) {
+		    auto tld = netquack::ExtractTLD(std::string_view(value.GetData(), value.GetSize()), domain_cache);
+		    if (!tld) {
+			    failures.fail(mask, idx);
+			    return string_t();
+		    }
+		    return netquack::LowerStringSlice(target, *tld);
+	    },
+	    &failures);
 }
 
 namespace netquack {
-std::string ExtractTLD(const std::string_view &input) {
+std::optional<std::string_view> ExtractTLD(const std::string_view &input, DomainCache &domain_cache) {
 	if (input.empty()) {
-		return "";
+		return std::nullopt;
 	}
 
 	const char *data = input.data();
@@ -45,28 +44,22 @@ std::string ExtractTLD(const std::string_view &input) {
 	// This handles cases like single words "com" that don't have dots
 	if (host.empty()) {
 		// Check if the input looks like a simple hostname (no protocol, path, etc.)
-		bool has_protocol = input.find("://") != std::string::npos;
-		bool has_path = input.find('/') != std::string::npos;
-		bool has_query = input.find('?') != std::string::npos;
-		bool has_fragment = input.find('#') != std::string::npos;
+		bool has_protocol = input.find("://") != std::string_view::npos;
+		bool has_path_query_fragment = find_first_symbols<'/', '?', '#'>(data, data + size) != data + size;
 
-		if (!has_protocol && !has_path && !has_query && !has_fragment) {
+		if (!has_protocol && !has_path_query_fragment) {
 			// Treat entire input as hostname, but strip port if present
 			size_t colon_pos = input.find(':');
-			size_t host_length = (colon_pos != std::string::npos) ? colon_pos : size;
+			size_t host_length = (colon_pos != std::string_view::npos) ? colon_pos : size;
 
 			// Reject single characters as invalid hostnames
 			if (host_length <= 1) {
-				{
-					return "";
-				}
+				return std::nullopt;
 			}
 
 			host = std::string_view(data, host_length);
 		} else {
-			{
-				return "";
-			}
+			return std::nullopt;
 		}
 	}
 
@@ -75,27 +68,14 @@ std::string ExtractTLD(const std::string_view &input) {
 		host.remove_suffix(1);
 	}
 
-	std::string host_str(host);
-
 	// For IPv4 addresses return empty
 	const char *last_dot = find_last_symbols_or_null<'.'>(host.data(), host.data() + host.size());
 	if (last_dot && isNumericASCII(last_dot[1])) {
-		return "";
-	}
-
-	// Use the proper TLD lookup to get the effective TLD
-	std::string effective_tld = getEffectiveTLD(host_str);
-
-	// If the effective TLD is empty, try the last part
-	if (effective_tld.empty()) {
-		size_t last_dot = host_str.find_last_of('.');
-		if (last_dot != std::string::npos) {
-			return host_str.substr(last_dot + 1);
-		}
-		return host_str; // No dots, return entire string
+		return std::string_view();
 	}
 
-	return effective_tld;
+	// The effective TLD falls back to the last label when no rule matches
+	return domain_cache.splitDomain(host).tld;
 }
 } // namespace netquack
 } // namespace duckdb
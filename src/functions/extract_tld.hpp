@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include "duckdb.hpp"
 
 namespace duckdb {
@@ -9,7 +11,9 @@ namespace duckdb {
 void ExtractTLDFunction(DataChunk &args, ExpressionState &state, Vector &result);
 
 namespace netquack {
-// Function to extract the top-level domain from a URL
-std::string ExtractTLD(const std::string_view &input);
+class DomainCache;
+
+// Function to extract the top-level domain from a URL, std::nullopt if the input has no host
+std::optional<std::string_view> ExtractTLD(const std::string_view &input, DomainCache &domain_cache);
 } // namespace netquack
 } // namespace duckdb
@@ -0,0 +1,113 @@
+// Copyright 2026 Arash Hatami
+
+#include "geoip_lookup.hpp"
+
+#include "duckdb/main/config.hpp"
+#include "ip_functions.hpp"
+#include "../utils/logger.hpp"
+
+namespace duckdb::netquack {
+namespace {
+template <class INPUT_TYPE>
+void LookupLocations(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &reader = *state.expr.Cast<BoundFunctionExpression>().bind_info->Cast<GeoIPLookupData>().reader;
+	auto &input = args.data[0];
+	auto count = args.size();
+	bool is_constant = input.GetVectorType() == VectorType::CONSTANT_VECTOR;
+	if (is_constant) {
+		count = 1;
+	}
+
+	UnifiedVectorFormat input_data;
+	input.ToUnifiedFormat(count, input_data);
+	auto inputs = UnifiedVectorFormat::GetData<INPUT_TYPE>(input_data);
+
+	// Children are filled in the order of GeoIPLookupType
+	auto &children = StructVector::GetEntries(result);
+	auto &country = *children[0];
+	auto &city = *children[1];
+	auto &asn = *children[2];
+	auto country_data = FlatVector::GetData<string_t>(country);
+	auto city_data = FlatVector::GetData<string_t>(city);
+	auto asn_data = FlatVector::GetData<uint32_t>(asn);
+	auto &result_validity = FlatVector::Validity(result);
+
+	for (idx_t i = 0; i < count; i++) {
+		auto idx = input_data.sel->get_index(i);
+		uhugeint_t address;
+		uint32_t record;
+		if (!input_data.validity.RowIsValid(idx) || !ToIPAddress(inputs[idx], address) ||
+		    !reader.find(address, record)) {
+			result_validity.SetInvalid(i);
+			for (auto &child : children) {
+				FlatVector::SetNull(*child, i, true);
+			}
+			continue;
+		}
+
+		// Only these paths of the record are decoded, the strings are copied straight out of the mapped file
+		std::string_view value;
+		if (reader.lookupString(record, {"country", "iso_code"}, value)) {
+			country_data[i] = StringVector::AddString(country, value.data(), value.size());
+		} else {
+			FlatVector::SetNull(country, i, true);
+		}
+		if (reader.lookupString(record, {"city", "names", "en"}, value)) {
+			city_data[i] = StringVector::AddString(city, value.data(), value.size());
+		} else {
+			FlatVector::SetNull(city, i, true);
+		}
+		uint64_t number;
+		if (reader.lookupUnsigned(record, {"autonomous_system_number"}, number) && number <= UINT32_MAX) {
+			asn_data[i] = static_cast<uint32_t>(number);
+		} else {
+			FlatVector::SetNull(asn, i, true);
+		}
+	}
+
+	if (is_constant) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	}
+}
+} // namespace
+
+unique_ptr<FunctionData> BindGeoIPLookupFunction(ClientContext &context, ScalarFunction &,
+                                                 vector<unique_ptr<Expression>> &arguments) {
+	// The file is opened once per query, so it has to be known before the first row
+	if (!arguments[1]->IsFoldable()) {
+		LogMessage(LogLevel::LOG_CRITICAL, "The GeoIP database path must be a constant");
+	}
+	auto path = ExpressionExecutor::EvaluateScalar(context, *arguments[1]);
+	if (path.IsNull()) {
+		LogMessage(LogLevel::LOG_CRITICAL, "The GeoIP database path must not be NULL");
+	}
+	auto file = path.GetValue<std::string>();
+	// The file is mapped directly, so the access settings of DuckDB's file system are checked here
+	if (!DBConfig::GetConfig(context).CanAccessFile(file, FileType::FILE_TYPE_REGULAR)) {
+		LogMessage(LogLevel::LOG_CRITICAL, "Cannot access GeoIP database `" + file +
+		                                       "` - file system operations are disabled by configuration");
+	}
+	std::string error;
+	auto reader = MMDBReader::open(file, error);
+	if (!reader) {
+		LogMessage(LogLevel::LOG_CRITICAL, error);
+	}
+	return make_uniq<GeoIPLookupData>(std::move(file), std::move(reader));
+}
+
+LogicalType GeoIPLookupType() {
+	child_list_t<LogicalType> children;
+	children.emplace_back("country", LogicalType::VARCHAR);
+	children.emplace_back("city", LogicalType::VARCHAR);
+	children.emplace_back("asn", LogicalType::UINTEGER);
+	return LogicalType::STRUCT(std::move(children));
+}
+
+void GeoIPLookupFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	LookupLocations<string_t>(args, state, result);
+}
+
+void GeoIPAddressLookupFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	LookupLocations<uhugeint_t>(args, state, result);
+}
+} // namespace duckdb::netquack
@@ -0,0 +1,38 @@
+// Copyright 2026 Arash Hatami
+
+#pragma once
+
+#include "duckdb.hpp"
+#include "../utils/mmdb_reader.hpp"
+
+namespace duckdb::netquack {
+// Bind data of geoip_lookup, the constant database path and the reader of that file
+struct GeoIPLookupData : public FunctionData {
+	GeoIPLookupData(std::string path, std::shared_ptr<const MMDBReader> reader)
+	    : path(std::move(path)), reader(std::move(reader)) {
+	}
+
+	std::string path;
+	std::shared_ptr<const MMDBReader> reader;
+
+	unique_ptr<FunctionData> Copy() const override {
+		return make_uniq<GeoIPLookupData>(path, reader);
+	}
+	bool Equals(const FunctionData &other) const override {
+		return path == other.Cast<GeoIPLookupData>().path;
+	}
+};
+
+// Opens the database of the constant path argument, fails when it is not a MaxMind DB file
+unique_ptr<FunctionData> BindGeoIPLookupFunction(ClientContext &context, ScalarFunction &bound_function,
+                                                 vector<unique_ptr<Expression>> &arguments);
+
+// STRUCT(country VARCHAR, city VARCHAR, asn UINTEGER)
+LogicalType GeoIPLookupType();
+
+// Scalar function: geoip_lookup(VARCHAR ip, VARCHAR path) -> STRUCT
+void GeoIPLookupFunction(DataChunk &args, ExpressionState &state, Vector &result);
+
+// Scalar function: geoip_lookup(IP ip, VARCHAR path) -> STRUCT
+void GeoIPAddressLookupFunction(DataChunk &args, ExpressionState &state, Vector &result);
+} // namespace duckdb::netquack
@@ -3,11 +3,27 @@
 #include "get_tranco.hpp"
 
 #include <curl/curl.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
 #include <regex>
+#include <thread>
+#include <vector>
 
+#include "duckdb/storage/object_cache.hpp"
 #include "../utils/logger.hpp"
+#include "tranco_history.hpp"
+#include "../utils/tranco_csv.hpp"
+#include "../utils/tranco_index.hpp"
+#include "../utils/url_helpers.hpp"
 #include "../utils/utils.hpp"
+#include "../utils/vector_helpers.hpp"
+#include "../utils/zip_reader.hpp"
 
 namespace duckdb::netquack {
 // Function to get the download code for the Tranco list
@@ -43,8 +59,205 @@ std::string GetTrancoDownloadCode(const char *date) {
 	return "";
 }
 
+namespace {
+// Stop a refresh that was cancelled, before its next step
+void CheckCancelled(const TrancoLoadOptions &options) {
+	if (options.cancelled && options.cancelled->load()) {
+		LogMessage(LogLevel::LOG_CRITICAL, "Tranco list refresh cancelled, the database is closing.");
+	}
+}
+
+// The database for the next step of a refresh. A background refresh only holds it while it writes to it, so closing
+// the database during a download cancels the download instead of waiting for it.
+std::shared_ptr<DatabaseInstance> LockDatabase(const std::weak_ptr<DatabaseInstance> &database,
+                                               const TrancoLoadOptions &options) {
+	CheckCancelled(options);
+	auto db = database.lock();
+	if (!db) {
+		LogMessage(LogLevel::LOG_CRITICAL, "Tranco list refresh cancelled, the database was closed.");
+	}
+	return db;
+}
+
+// Abort a transfer of a refresh that was cancelled
+int CancelTransferCallback(void *cancelled, curl_off_t, curl_off_t, curl_off_t, curl_off_t) {
+	return static_cast<const std::atomic_bool *>(cancelled)->load() ? 1 : 0;
+}
+
+void SetCancelCallback(CURL *curl, const TrancoLoadOptions &options) {
+	if (!options.cancelled) {
+		return;
+	}
+	curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, CancelTransferCallback);
+	curl_easy_setopt(curl, CURLOPT_XFERINFODATA, const_cast<std::atomic_bool *>(options.cancelled));
+	curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+}
+
+// Absolute path of the snapshot of the list of `date`, next to the database file or in the working directory for an
+// in-memory database. The table comment keeps the path, which must still be valid from another working directory.
+std::string TrancoSnapshotPath(ClientContext &context, const std::string &date) {
+	std::filesystem::path directory;
+	auto &database_path = DBConfig::GetConfig(context).options.database_path;
+	if (!database_path.empty() && database_path != ":memory:") {
+		directory = std::filesystem::path(database_path).parent_path();
+	}
+	auto path = directory / ("tranco_list_" + date + ".idx");
+	std::error_code error;
+	auto absolute_path = std::filesystem::absolute(path, error);
+	return (error ? path : absolute_path).string();
+}
+
+// Build the snapshot of `index`, record the history, commit the transaction of `con` that replaced `tranco_list`
+// and publish the index
+void FinishTrancoList(Connection &con, std::shared_ptr<const TrancoIndex> index, const std::string &date,
+                      const TrancoLoadOptions &options) {
+	// Keep a snapshot of the index next to the list and name it in the table comment. Other processes and later
+	// sessions on this database map the snapshot instead of reading the whole table again.
+	std::string snapshot_file = TrancoSnapshotPath(*con.context, date);
+	if (index->save(snapshot_file)) {
+		auto comment = TrancoIndex::SNAPSHOT_COMMENT_PREFIX + StringUtil::Replace(snapshot_file, "'", "''");
+		auto result = con.Query("COMMENT ON TABLE tranco_list IS '" + comment + "'");
+		if (result->HasError()) {
+			LogMessage(LogLevel::LOG_CRITICAL, result->GetError());
+		}
+	} else {
+		LogMessage(LogLevel::LOG_WARNING, "Failed to write Tranco snapshot `" + snapshot_file + "`");
+		snapshot_file.clear();
+	}
+	// The history changes with the list or not at all
+	if (options.history) {
+		RecordTrancoHistory(con, date);
+	}
+	con.Commit();
+
+	// Serve the list from the mapped snapshot like later sessions do, the index built in memory is dropped
+	if (!snapshot_file.empty()) {
+		if (auto mapped = TrancoIndex::open(snapshot_file)) {
+			index = std::move(mapped);
+		}
+	}
+	// Swap the new index in, queries that are running keep the one they started with
+	con.context->RunFunctionInTransaction([&]() { TrancoIndex::publish(*con.context, index, snapshot_file); });
+}
+
+// Replace `tranco_list` with the lines `read` feeds to the parser, appending them to the table and the index as they
+// arrive. Nothing is written to disk but the snapshot.
+void AppendTrancoList(DatabaseInstance &db, const std::string &date, const TrancoLoadOptions &options,
+                      const std::function<void(TrancoCsvParser &parser)> &read) {
+	Connection con(db);
+	con.BeginTransaction();
+	auto result = con.Query("CREATE OR REPLACE TABLE tranco_list (rank INTEGER, domain VARCHAR, category VARCHAR)");
+	if (result->HasError()) {
+		LogMessage(LogLevel::LOG_CRITICAL, result->GetError());
+	}
+
+	TrancoIndex::Builder builder;
+	Appender appender(con, "tranco_list");
+	TrancoCsvParser parser([&](uint32_t rank, std::string_view domain) {
+		builder.add(domain, rank);
+		appender.BeginRow();
+		appender.Append<int32_t>(static_cast<int32_t>(rank));
+		appender.Append(string_t(domain.data(), static_cast<uint32_t>(domain.size())));
+		appender.Append(TrancoIndex::CATEGORIES[TrancoIndex::category(rank)]);
+		appender.EndRow();
+	});
+	read(parser);
+	parser.finish();
+	if (parser.malformed() > 0) {
+		LogMessage(LogLevel::LOG_WARNING,
+		           "Skipped " + std::to_string(parser.malformed()) + " malformed lines of the Tranco list");
+	}
+	// Keep the current list rather than replacing it with nothing
+	if (parser.rows() == 0) {
+		LogMessage(LogLevel::LOG_CRITICAL, "The Tranco list is empty.");
+	}
+	appender.Close();
+
+	FinishTrancoList(con, builder.build(date), date, options);
+}
+
+// Download the list from `url` straight into the table and the index, parsing overlaps the download
+void StreamTrancoList(DatabaseInstance &db, const std::string &url, const std::string &date,
+                      const TrancoLoadOptions &options) {
+	LogMessage(LogLevel::LOG_INFO, "Stream Tranco list: " + url);
+
+	AppendTrancoList(db, date, options, [&](TrancoCsvParser &parser) {
+		CURL *curl = CreateCurlHandler(WriteTrancoCsvCallback);
+		curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+		curl_easy_setopt(curl, CURLOPT_WRITEDATA, &parser);
+		// An error page must not be parsed as the list
+		curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
+		SetCancelCallback(curl, options);
+		CURLcode res = curl_easy_perform(curl);
+		curl_easy_cleanup(curl);
+
+		if (!parser.error.empty()) {
+			LogMessage(LogLevel::LOG_CRITICAL, parser.error);
+		}
+		CheckCancelled(options);
+		if (res != CURLE_OK) {
+			LogMessage(LogLevel::LOG_ERROR, std::string(curl_easy_strerror(res)));
+			LogMessage(LogLevel::LOG_CRITICAL, "Failed to download Tranco list. Check logs for details.");
+		}
+	});
+}
+
+// Import the list in the zip archive at `path`, inflating it straight into the table and the index
+void ImportTrancoZip(DatabaseInstance &db, const std::string &path, const std::string &date,
+                     const TrancoLoadOptions &options) {
+	LogMessage(LogLevel::LOG_INFO, "Import Tranco list from zip archive: " + path);
+
+	AppendTrancoList(db, date, options, [&](TrancoCsvParser &parser) {
+		ReadZipEntry(FileSystem::GetFileSystem(db), path, [&](const char *data, size_t size) {
+			CheckCancelled(options);
+			parser.feed(data, size);
+		});
+	});
+}
+
+// Replace `tranco_list` with the list in `csv_file`, which DuckDB reads in parallel and decompresses if its name
+// ends in .gz or .zst
+void InsertTrancoList(DatabaseInstance &db, const std::string &csv_file, const std::string &date,
+                      const TrancoLoadOptions &options) {
+	// Parse the CSV data and insert into a table
+	LogMessage(LogLevel::LOG_INFO, "Inserting Tranco list into table");
+
+	// Replace the table, build its index and name the snapshot in one transaction. Queries keep seeing the old table
+	// with its index until the commit, there is no moment without a table.
+	Connection con(db);
+	con.BeginTransaction();
+	string query = "CREATE OR REPLACE TABLE tranco_list AS"
+	               " SELECT rank,"
+	               " domain,"
+	               " CASE"
+	               " WHEN rank <= 1000 THEN 'top1k'"
+	               " WHEN rank <= 5000 THEN 'top5k'"
+	               " WHEN rank <= 10000 THEN 'top10k'"
+	               " WHEN rank <= 50000 THEN 'top50k'"
+	               " WHEN rank <= 100000 THEN 'top100k'"
+	               " WHEN rank <= 500000 THEN 'top500k'"
+	               " WHEN rank <= 1000000 THEN 'top1m'"
+	               " WHEN rank <= 5000000 THEN 'top5m'"
+	               " ELSE 'other'"
+	               " END AS category"
+	               " FROM read_csv('" +
+	               StringUtil::Replace(csv_file, "'", "''") +
+	               "', header = false, columns = { 'rank': 'INTEGER', 'domain': 'VARCHAR' })";
+	auto result = con.Query(query);
+
+	if (result->HasError()) {
+		LogMessage(LogLevel::LOG_CRITICAL, result->GetError());
+	}
+
+	// Build the rank index now rather than in the first query that looks up a rank
+	FinishTrancoList(con, TrancoIndex::load(con, "tranco_list", date), date, options);
+}
+
+} // namespace
+
 // Function to download the Tranco list and create a table
-void LoadTrancoList(DatabaseInstance &db, bool force) {
+void LoadTrancoList(const std::weak_ptr<DatabaseInstance> &database, const TrancoLoadOptions &options) {
+	CheckCancelled(options);
 	// Get yesterday's date in YYYY-MM-DD format
 	std::time_t now = std::time(nullptr);
 	std::tm yesterday_tm;
@@ -63,8 +276,31 @@ void LoadTrancoList(DatabaseInstance &db, bool force) {
 	// Remove trailing null character(s)
 	date.resize(std::strlen(date.c_str()));
 
+	// An earlier list, for example to fill the history
+	if (!options.list_date.empty()) {
+		if (!std::regex_match(options.list_date, std::regex(R"(\d{4}-\d{2}-\d{2})"))) {
+			LogMessage(LogLevel::LOG_CRITICAL, "Invalid Tranco list date `" + options.list_date + "`, use YYYY-MM-DD");
+		}
+		date = options.list_date;
+	}
+
+	// A list copied to this host, no network is needed
+	if (!options.list_path.empty()) {
+		auto db = LockDatabase(database, options);
+		if (IsZipArchive(FileSystem::GetFileSystem(*db), options.list_path)) {
+			ImportTrancoZip(*db, options.list_path, date, options);
+			return;
+		}
+		LogMessage(LogLevel::LOG_INFO, "Import Tranco list: " + options.list_path);
+		InsertTrancoList(*db, options.list_path, date, options);
+		return;
+	}
+
 	// Construct filename
 	std::string temp_file = "tranco_list_" + date + ".csv";
+	// Refreshes of different databases run side by side, but the downloaded file is shared by all of them
+	static std::mutex download_lock;
+	std::unique_lock<std::mutex> download_guard(download_lock);
 
 	// Check if file exists before download
 	bool file_exists = false;
@@ -74,16 +310,25 @@ void LoadTrancoList(DatabaseInstance &db, bool force) {
 	}
 
 	// Download the file if it doesn't exist or if force is true
-	if (force) {
+	if (options.force) {
+		// Construct the download URL
+		std::string download_url = options.list_url;
+		if (download_url.empty()) {
+			// Get the download code
+			std::string download_code = GetTrancoDownloadCode(date.c_str());
+			download_url = "https://tranco-list.eu/download/" + download_code + "/full";
+		}
+
+		if (options.stream) {
+			download_guard.unlock();
+			StreamTrancoList(*LockDatabase(database, options), download_url, date, options);
+			return;
+		}
+
 		// Remove the old file if it exists
 		if (file_exists) {
 			remove(temp_file.c_str());
 		}
-		// Get the download code
-		std::string download_code = GetTrancoDownloadCode(date.c_str());
-
-		// Construct the download URL
-		std::string download_url = "https://tranco-list.eu/download/" + download_code + "/full";
 
 		LogMessage(LogLevel::LOG_INFO, "Download Tranco list: " + download_url);
 
@@ -98,12 +343,16 @@ void LoadTrancoList(DatabaseInstance &db, bool force) {
 
 		curl_easy_setopt(curl, CURLOPT_URL, download_url.c_str());
 		curl_easy_setopt(curl, CURLOPT_WRITEDATA, download_file);
+		// An error page must not be imported as the list
+		curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
+		SetCancelCallback(curl, options);
 		res = curl_easy_perform(curl);
 		curl_easy_cleanup(curl);
 		fclose(download_file);
 
 		if (res != CURLE_OK) {
 			remove(temp_file.c_str()); // Clean up the temporary file
+			CheckCancelled(options);
 			LogMessage(LogLevel::LOG_ERROR, std::string(curl_easy_strerror(res)));
 			LogMessage(LogLevel::LOG_CRITICAL, "Failed to download Tranco list. Check logs for details.");
 		}
@@ -116,146 +365,334 @@ void LoadTrancoList(DatabaseInstance &db, bool force) {
 		           "Tranco list `" + temp_file + "` not found. Download it first using `SELECT update_tranco(true);`");
 	}
 
-	// Parse the CSV data and insert into a table
-	LogMessage(LogLevel::LOG_INFO, "Inserting Tranco list into table");
+	InsertTrancoList(*LockDatabase(database, options), temp_file, date, options);
+}
 
-	Connection con(db);
-	string query = "CREATE OR REPLACE TABLE tranco_list AS"
-	               " SELECT rank,"
-	               " domain,"
-	               " CASE"
-	               " WHEN rank <= 1000 THEN 'top1k'"
-	               " WHEN rank <= 5000 THEN 'top5k'"
-	               " WHEN rank <= 10000 THEN 'top10k'"
-	               " WHEN rank <= 50000 THEN 'top50k'"
-	               " WHEN rank <= 100000 THEN 'top100k'"
-	               " WHEN rank <= 500000 THEN 'top500k'"
-	               " WHEN rank <= 1000000 THEN 'top1m'"
-	               " WHEN rank <= 5000000 THEN 'top5m'"
-	               " ELSE 'other'"
-	               " END AS category"
-	               " FROM read_csv('" +
-	               temp_file + "', header = false, columns = { 'rank': 'INTEGER', 'domain': 'VARCHAR' })";
-	auto result = con.Query(query);
+namespace {
+// Refresh state of one database. Its refreshes run one at a time, a second one waits for the first.
+struct RefreshState {
+	std::mutex lock;
+	std::atomic_bool running {false};
+	// Set when the database is closed or the process exits, the refresh stops before its next step
+	std::atomic_bool cancelled {false};
+	std::mutex error_lock;
+	std::string error;
+	// The last background refresh, joined before the next one starts and when the refresh is stopped
+	std::mutex thread_lock;
+	std::thread thread;
+
+	// Cancel the background refresh and wait for it
+	void stop() {
+		cancelled = true;
+		std::lock_guard<std::mutex> guard(thread_lock);
+		if (!thread.joinable()) {
+			return;
+		}
+		// The refresh released the last reference to its database itself, it is returning anyway
+		if (thread.get_id() == std::this_thread::get_id()) {
+			thread.detach();
+			return;
+		}
+		thread.join();
+	}
+};
+
+// Keeps the refresh state of a database in its object cache, so the state lives as long as the database and the
+// background refresh is stopped when the database shuts down
+class RefreshStateEntry : public ObjectCacheEntry {
+public:
+	~RefreshStateEntry() override {
+		state->stop();
+	}
 
-	if (result->HasError()) {
-		LogMessage(LogLevel::LOG_CRITICAL, result->GetError());
+	static std::string ObjectType() {
+		return "netquack_tranco_refresh";
+	}
+	std::string GetObjectType() override {
+		return ObjectType();
+	}
+	// Never evicted, evicting the entry would cancel the refresh
+	optional_idx GetEstimatedCacheMemory() const {
+		return optional_idx();
 	}
-}
 
-// Function to update the Tranco list table
-void UpdateTrancoListFunction(DataChunk &args, ExpressionState &state, Vector &result) {
-	// Extract the force_download argument
-	auto &force_download_vector = args.data[0];
-	bool force_download = force_download_vector.GetValue(0).GetValue<bool>();
+	std::shared_ptr<RefreshState> state = std::make_shared<RefreshState>();
+};
 
-	// Load the Tranco list into the database
-	auto &db = *state.GetContext().db;
-	netquack::LoadTrancoList(db, force_download);
+// Background refreshes of every database, stopped at exit before the static objects they use are destroyed
+struct RefreshThreads {
+	std::mutex lock;
+	std::vector<std::weak_ptr<RefreshState>> states;
 
-	result.SetValue(0, Value("Tranco list updated"));
-}
+	~RefreshThreads() {
+		for (auto &entry : states) {
+			if (auto state = entry.lock()) {
+				state->stop();
+			}
+		}
+	}
 
-// Function to get the Tranco rank of a domain
-void GetTrancoRankFunction(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &db = *state.GetContext().db;
-	Connection con(db);
+	void add(const std::shared_ptr<RefreshState> &state) {
+		std::lock_guard<std::mutex> guard(lock);
+		states.erase(std::remove_if(states.begin(), states.end(),
+		                            [](const std::weak_ptr<RefreshState> &entry) { return entry.expired(); }),
+		             states.end());
+		states.push_back(state);
+	}
+};
 
-	auto table_exists = con.Query("SELECT 1 FROM information_schema.tables WHERE table_name = 'tranco_list'");
-	auto check_chunk = table_exists->Fetch();
+RefreshThreads &refreshThreads() {
+	static RefreshThreads threads;
+	return threads;
+}
 
-	if (!check_chunk || check_chunk->size() == 0) {
-		LogMessage(LogLevel::LOG_CRITICAL,
-		           "Tranco table not found. Download it first using `SELECT update_tranco(true);`");
+std::shared_ptr<RefreshState> GetRefreshState(DatabaseInstance &db) {
+	return db.GetObjectCache().GetOrCreate<RefreshStateEntry>(RefreshStateEntry::ObjectType())->state;
+}
+
+// Load the list and keep the error for tranco_status(), empty if the refresh succeeded
+std::string RefreshTrancoList(const std::weak_ptr<DatabaseInstance> &database, RefreshState &state,
+                              const TrancoLoadOptions &options) {
+	std::lock_guard<std::mutex> guard(state.lock);
+	std::string error;
+	try {
+		LoadTrancoList(database, options);
+	} catch (std::exception &ex) {
+		error = ex.what();
 	}
+	std::lock_guard<std::mutex> error_guard(state.error_lock);
+	state.error = error;
+	return error;
+}
+} // namespace
 
-	// Extract the input from the arguments
-	const auto &input_vector = args.data[0];
-	auto result_data = FlatVector::GetData<string_t>(result);
-	auto &result_validity = FlatVector::Validity(result);
+TrancoRefreshStatus GetTrancoRefreshStatus(DatabaseInstance &db) {
+	auto state = GetRefreshState(db);
+	std::lock_guard<std::mutex> guard(state->error_lock);
+	return {state->running, state->error};
+}
 
-	for (idx_t i = 0; i < args.size(); i++) {
-		auto value = input_vector.GetValue(i);
-		if (value.IsNull()) {
-			result_validity.SetInvalid(i);
-			continue;
+// Function to update the Tranco list table
+void UpdateTrancoListFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	// Extract the force_download argument
+	auto &force_download_vector = args.data[0];
+	TrancoLoadOptions options;
+	if (force_download_vector.GetType().id() == LogicalTypeId::VARCHAR) {
+		// update_tranco(path) imports a local file
+		auto path = force_download_vector.GetValue(0);
+		if (path.IsNull() || path.GetValue<std::string>().empty()) {
+			LogMessage(LogLevel::LOG_CRITICAL, "The Tranco list path must not be empty");
 		}
+		options.list_path = path.GetValue<std::string>();
+		// Checked with the file system of the client, which applies the file access settings
+		if (!FileSystem::GetFileSystem(state.GetContext()).FileExists(options.list_path)) {
+			LogMessage(LogLevel::LOG_CRITICAL, "Tranco list `" + options.list_path + "` not found");
+		}
+	} else {
+		options.force = force_download_vector.GetValue(0).GetValue<bool>();
+	}
+	bool background = args.ColumnCount() > 1 && args.data[1].GetValue(0).GetValue<bool>();
 
-		auto input = value.ToString();
-		std::transform(input.begin(), input.end(), input.begin(), ::tolower);
-
-		try {
-			auto prepared = con.Prepare("SELECT rank FROM tranco_list WHERE domain = $1");
-			auto query_result = prepared->Execute(input);
-
-			if (query_result->HasError()) {
-				result_validity.SetInvalid(i);
-				continue;
-			}
+	// The settings are read here, a background refresh has no client context
+	auto &context = state.GetContext();
+	Value setting;
+	if (context.TryGetCurrentSetting("netquack_tranco_streaming", setting) && !setting.IsNull()) {
+		options.stream = setting.GetValue<bool>();
+	}
+	if (context.TryGetCurrentSetting("netquack_tranco_list_url", setting) && !setting.IsNull()) {
+		options.list_url = setting.GetValue<std::string>();
+	}
+	if (context.TryGetCurrentSetting("netquack_tranco_list_date", setting) && !setting.IsNull()) {
+		options.list_date = setting.GetValue<std::string>();
+	}
+	if (context.TryGetCurrentSetting("netquack_tranco_history", setting) && !setting.IsNull()) {
+		options.history = setting.GetValue<bool>();
+	}
 
-			auto chunk = query_result->Fetch();
-			if (chunk && chunk->size() > 0) {
-				auto rank = chunk->GetValue(0, 0);
-				result_data[i] = StringVector::AddString(result, rank.ToString());
-			} else {
-				// Domain not found - return NULL
-				result_validity.SetInvalid(i);
-			}
-		} catch (const std::exception &e) {
-			result_data[i] = StringVector::AddString(result, "Error extracting tranco rank: " + std::string(e.what()));
+	auto &db = *context.db;
+	auto refresh_state = GetRefreshState(db);
+	if (!background) {
+		// Load the Tranco list into the database
+		auto error = RefreshTrancoList(db.shared_from_this(), *refresh_state, options);
+		if (!error.empty()) {
+			throw std::runtime_error(error);
 		}
+		result.SetValue(0, Value("Tranco list updated"));
+		return;
 	}
-}
 
-// Function to get the Tranco rank category of a domain
-void GetTrancoRankCategoryFunction(DataChunk &args, ExpressionState &state, Vector &result) {
-	auto &db = *state.GetContext().db;
-	Connection con(db);
+	if (refresh_state->running.exchange(true)) {
+		result.SetValue(0, Value("Tranco list refresh already running"));
+		return;
+	}
+	options.cancelled = &refresh_state->cancelled;
+	refreshThreads().add(refresh_state);
+	std::lock_guard<std::mutex> thread_guard(refresh_state->thread_lock);
+	if (refresh_state->thread.joinable()) {
+		// The previous refresh is done, it cleared `running`
+		refresh_state->thread.join();
+	}
+	// The thread doesn't keep the database open, closing it stops the refresh
+	refresh_state->thread = std::thread([database = std::weak_ptr<DatabaseInstance>(db.shared_from_this()),
+	                                     refresh_state, options]() {
+		// The error is kept in the refresh state and reported by tranco_status()
+		RefreshTrancoList(database, *refresh_state, options);
+		refresh_state->running = false;
+	});
+	result.SetValue(0, Value("Tranco list refresh started"));
+}
 
-	auto table_exists = con.Query("SELECT 1 FROM information_schema.tables WHERE table_name = 'tranco_list'");
-	auto chunk = table_exists->Fetch();
+namespace {
+// Name to look up for `value`: the value itself, or for a suffix walk the host of the URL without a trailing dot
+std::string_view lookupName(const string_t &value, bool suffix_walk) {
+	std::string_view name(value.GetData(), value.GetSize());
+	if (!suffix_walk) {
+		return name;
+	}
+	auto host = getURLHost(name.data(), name.size());
+	if (!host.empty() && host.back() == '.') {
+		host.remove_suffix(1);
+	}
+	return host;
+}
 
-	if (!chunk || chunk->size() == 0) {
-		LogMessage(LogLevel::LOG_CRITICAL,
-		           "Tranco table not found. Download it first using `SELECT update_tranco(true);`");
+// Rank of the first listed name among `host` and its parent domains down to its registrable domain
+uint32_t walkSuffixes(const TrancoIndex &index, DomainCache &domain_cache, std::string_view host, uint64_t hash) {
+	auto rank = index.rank(host, hash);
+	if (rank != 0) {
+		return rank;
 	}
+	// The public suffix list is only consulted for hosts that are not listed themselves
+	auto registrable = domain_cache.splitDomain(host).domain;
+	while (registrable.size() < host.size()) {
+		host.remove_prefix(host.find('.') + 1);
+		rank = index.rank(host);
+		if (rank != 0) {
+			return rank;
+		}
+	}
+	return 0;
+}
 
-	// Extract the input from the arguments
-	const auto &input_vector = args.data[0];
-	auto result_data = FlatVector::GetData<string_t>(result);
-	auto &result_validity = FlatVector::Validity(result);
+// Probe the Tranco index for every row of `input`, `emit(rank, target)` produces the result of listed domains.
+// The whole chunk is hashed and its slots prefetched before the first probe, so the cache misses of a large index
+// overlap instead of being paid one row at a time.
+template <class RESULT_TYPE, class EMIT>
+void LookupRanks(ExpressionState &state, Vector &input, Vector &result, idx_t count, EMIT &&emit) {
+	auto &local_state = TrancoIndexLocalState::Get(state);
+	auto &index = *local_state.index;
+	auto domain_cache = local_state.domain_cache.get();
+	// Keep one suffix list for the whole chunk, even if another one is installed meanwhile
+	std::shared_ptr<const PublicSuffixList> suffix_list;
+	if (domain_cache) {
+		suffix_list = PublicSuffixList::current();
+		domain_cache->setList(*suffix_list);
+	}
 
-	for (idx_t i = 0; i < args.size(); i++) {
-		auto value = input_vector.GetValue(i);
-		if (value.IsNull()) {
-			result_validity.SetInvalid(i);
-			continue;
+	ExecuteDistinct(input, result, count, [&](Vector &source, Vector &target, idx_t source_count) {
+		UnifiedVectorFormat source_data;
+		source.ToUnifiedFormat(source_count, source_data);
+		auto values = UnifiedVectorFormat::GetData<string_t>(source_data);
+
+		std::string_view names[STANDARD_VECTOR_SIZE];
+		uint64_t hashes[STANDARD_VECTOR_SIZE];
+		for (idx_t i = 0; i < source_count; ++i) {
+			auto source_idx = source_data.sel->get_index(i);
+			if (source_data.validity.RowIsValid(source_idx)) {
+				names[i] = lookupName(values[source_idx], domain_cache != nullptr);
+				hashes[i] = TrancoIndex::hash(names[i]);
+				index.prefetch(hashes[i]);
+			}
 		}
 
-		auto input = value.ToString();
-		std::transform(input.begin(), input.end(), input.begin(), ::tolower);
+		UnaryExecutor::ExecuteWithNulls<string_t, RESULT_TYPE>(
+		    source, target, source_count, [&](string_t, ValidityMask &mask, idx_t idx) {
+			    auto rank = domain_cache ? walkSuffixes(index, *domain_cache, names[idx], hashes[idx])
+			                             : index.rank(names[idx], hashes[idx]);
+			    if (rank == 0) {
+				    // Domain not found
+				    mask.SetInvalid(idx);
+				    return RESULT_TYPE();
+			    }
+			    return emit(rank, target);
+		    });
+	});
+}
+} // namespace
 
-		try {
-			auto prepared = con.Prepare("SELECT category FROM tranco_list WHERE domain = $1");
-			auto query_result = prepared->Execute(input);
+LogicalType TrancoCategoryType() {
+	Vector categories(LogicalType::VARCHAR, TrancoIndex::CATEGORY_COUNT);
+	auto category_data = FlatVector::GetData<string_t>(categories);
+	for (idx_t i = 0; i < TrancoIndex::CATEGORY_COUNT; ++i) {
+		category_data[i] = StringVector::AddString(categories, TrancoIndex::CATEGORIES[i]);
+	}
+	return LogicalType::ENUM(categories, TrancoIndex::CATEGORY_COUNT);
+}
 
-			if (query_result->HasError()) {
-				result_validity.SetInvalid(i);
-				continue;
-			}
+unique_ptr<FunctionData> BindTrancoRankFunction(ClientContext &context, ScalarFunction &bound_function,
+                                                vector<unique_ptr<Expression>> &arguments) {
+	Value legacy_types;
+	if (context.TryGetCurrentSetting("netquack_tranco_legacy_types", legacy_types) && !legacy_types.IsNull() &&
+	    legacy_types.GetValue<bool>()) {
+		bound_function.return_type = LogicalType::VARCHAR;
+	}
+	if (arguments.size() < 2) {
+		return make_uniq<TrancoLookupData>(false);
+	}
 
-			auto result_chunk = query_result->Fetch();
-			if (result_chunk && result_chunk->size() > 0) {
-				auto category = result_chunk->GetValue(0, 0);
-				result_data[i] = StringVector::AddString(result, category.ToString());
-			} else {
-				// Domain not found - return NULL
-				result_validity.SetInvalid(i);
-			}
-		} catch (const std::exception &e) {
-			result_data[i] =
-			    StringVector::AddString(result, "Error extracting tranco category: " + std::string(e.what()));
-		}
+	// The fallback picks the kernel, so it has to be known before the first row
+	if (!arguments[1]->IsFoldable()) {
+		LogMessage(LogLevel::LOG_CRITICAL, "The Tranco fallback must be a constant");
+	}
+	auto fallback = ExpressionExecutor::EvaluateScalar(context, *arguments[1]);
+	auto fallback_name = fallback.IsNull() ? std::string() : StringUtil::Lower(fallback.GetValue<std::string>());
+	if (fallback_name == "none") {
+		return make_uniq<TrancoLookupData>(false);
+	}
+	if (fallback_name == "suffix_walk") {
+		return make_uniq<TrancoLookupData>(true);
+	}
+	LogMessage(LogLevel::LOG_CRITICAL, "Unknown Tranco fallback `" + fallback.ToString() +
+	                                       "`, expected 'none' or 'suffix_walk'");
+	return nullptr;
+}
+
+// Function to get the Tranco rank of a domain
+void GetTrancoRankFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	if (result.GetType().id() == LogicalTypeId::VARCHAR) {
+		LookupRanks<string_t>(state, args.data[0], result, args.size(), [](uint32_t rank, Vector &target) {
+			return StringVector::AddString(target, std::to_string(rank));
+		});
+		return;
 	}
+	LookupRanks<int32_t>(state, args.data[0], result, args.size(),
+	                     [](uint32_t rank, Vector &) { return static_cast<int32_t>(rank); });
+}
+
+// Function to get the Tranco rank category of a domain
+void GetTrancoRankCategoryFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	if (result.GetType().id() == LogicalTypeId::VARCHAR) {
+		// Category names are short enough to be inlined, no string is allocated per row
+		LookupRanks<string_t>(state, args.data[0], result, args.size(), [](uint32_t rank, Vector &) {
+			return string_t(TrancoIndex::CATEGORIES[TrancoIndex::category(rank)]);
+		});
+		return;
+	}
+	// The ENUM code is the position of the bucket
+	LookupRanks<uint8_t>(state, args.data[0], result, args.size(),
+	                     [](uint32_t rank, Vector &) { return TrancoIndex::category(rank); });
+}
+
+// Function to check whether a domain is ranked within the top `max_rank` of the Tranco list
+void InTrancoTopFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &index = *TrancoIndexLocalState::Get(state).index;
+	BinaryExecutor::Execute<string_t, int32_t, bool>(
+	    args.data[0], args.data[1], result, args.size(), [&](string_t domain, int32_t max_rank) {
+		    if (max_rank <= 0) {
+			    return false;
+		    }
+		    std::string_view name(domain.GetData(), domain.GetSize());
+		    return index.inTop(name, TrancoIndex::hash(name), static_cast<uint32_t>(max_rank));
+	    });
 }
 } // namespace duckdb::netquack
@@ -5,12 +5,31 @@
 #include "duckdb.hpp"
 
 namespace duckdb::netquack {
-// Function to update the Tranco list table
+// Function to update the Tranco list table, in the background if the optional second argument is true.
+// A VARCHAR first argument is the path of a local list to import instead of the force flag.
 void UpdateTrancoListFunction(DataChunk &args, ExpressionState &state, Vector &result);
 
+// State of the Tranco list refreshes of one database
+struct TrancoRefreshStatus {
+	bool running;           // a background refresh is in progress
+	std::string last_error; // error of the last refresh, empty if it succeeded
+};
+TrancoRefreshStatus GetTrancoRefreshStatus(DatabaseInstance &db);
+
+// ENUM of the Tranco rank categories, ordered from the best to the worst bucket
+LogicalType TrancoCategoryType();
+
+// Bind of the rank functions, reads the constant fallback argument ('none' or 'suffix_walk').
+// `netquack_tranco_legacy_types` switches them back to VARCHAR results.
+unique_ptr<FunctionData> BindTrancoRankFunction(ClientContext &context, ScalarFunction &bound_function,
+                                                vector<unique_ptr<Expression>> &arguments);
+
 // Function to get the Tranco rank of a domain
 void GetTrancoRankFunction(DataChunk &args, ExpressionState &state, Vector &result);
 
 // Function to get the Tranco rank category of a domain
 void GetTrancoRankCategoryFunction(DataChunk &args, ExpressionState &state, Vector &result);
+
+// Function to check whether a domain is ranked within the top N of the Tranco list
+void InTrancoTopFunction(DataChunk &args, ExpressionState &state, Vector &result);
 } // namespace duckdb::netquack
@@ -5,187 +5,168 @@
 #include <array>
 #include <charconv>
 #include <cstdint>
-#include <sstream>
 #include <string>
-#include <vector>
+#include <string_view>
+
+#include "../utils/vector_helpers.hpp"
 
 namespace duckdb {
 namespace netquack {
 
 // ---------------------------------------------------------------------------
-// IPv4 validation
+// IPv4 parsing
 // ---------------------------------------------------------------------------
-bool IsValidIPv4(const std::string &ip) {
+bool ParseIPv4(std::string_view ip, uint32_t &address) {
 	if (ip.empty() || ip.size() > 15) {
 		return false;
 	}
 
-	int dot_count = 0;
-	int octet_start = 0;
-
-	for (size_t i = 0; i <= ip.size(); ++i) {
-		if (i == ip.size() || ip[i] == '.') {
-			int len = static_cast<int>(i) - octet_start;
-			if (len == 0 || len > 3) {
-				return false;
-			}
-
-			// Check all digits
-			for (int j = octet_start; j < static_cast<int>(i); ++j) {
-				if (ip[j] < '0' || ip[j] > '9') {
-					return false;
-				}
-			}
-
-			// No leading zeros (except for "0" itself)
-			if (len > 1 && ip[octet_start] == '0') {
-				return false;
-			}
-
-			// Parse and range-check
-			int val = 0;
-			auto result = std::from_chars(ip.data() + octet_start, ip.data() + i, val);
-			if (result.ec != std::errc {} || val < 0 || val > 255) {
-				return false;
-			}
-
-			if (ip[i] == '.') {
-				dot_count++;
-				if (dot_count > 3) {
-					return false;
-				}
-			}
-
-			octet_start = static_cast<int>(i) + 1;
+	uint32_t value = 0;
+	int octets = 0;
+	size_t i = 0;
+	while (true) {
+		size_t octet_start = i;
+		uint32_t octet = 0;
+		while (i < ip.size() && i - octet_start < 3 && ip[i] >= '0' && ip[i] <= '9') {
+			octet = octet * 10 + static_cast<uint32_t>(ip[i] - '0');
+			++i;
 		}
-	}
 
-	return dot_count == 3;
-}
+		// One to three digits up to 255, no leading zeros (except for "0" itself)
+		size_t len = i - octet_start;
+		if (len == 0 || octet > 255 || (len > 1 && ip[octet_start] == '0')) {
+			return false;
+		}
+		value = (value << 8) | octet;
+		++octets;
 
-// ---------------------------------------------------------------------------
-// IPv6 validation
-// ---------------------------------------------------------------------------
-static bool IsValidIPv6Group(const std::string &group) {
-	if (group.empty() || group.size() > 4) {
-		return false;
-	}
-	for (char c : group) {
-		if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'))) {
+		if (i == ip.size()) {
+			break;
+		}
+		if (ip[i] != '.' || octets == 4) {
 			return false;
 		}
+		++i;
 	}
-	return true;
-}
 
-bool IsValidIPv6(const std::string &ip) {
-	if (ip.empty()) {
+	if (octets != 4) {
 		return false;
 	}
+	address = value;
+	return true;
+}
 
-	// Strip surrounding brackets if present: [::1] -> ::1
-	std::string addr = ip;
-	if (addr.front() == '[' && addr.back() == ']') {
-		addr = addr.substr(1, addr.size() - 2);
-	}
+bool IsValidIPv4(std::string_view ip) {
+	uint32_t address;
+	return ParseIPv4(ip, address);
+}
 
-	if (addr.empty()) {
-		return false;
+// ---------------------------------------------------------------------------
+// IPv6 parsing
+// ---------------------------------------------------------------------------
+static inline int HexDigit(char c) {
+	if (c >= '0' && c <= '9') {
+		return c - '0';
 	}
-
-	// Handle IPv4-mapped IPv6 (e.g. ::ffff:192.168.1.1)
-	size_t last_colon = addr.rfind(':');
-	if (last_colon != std::string::npos) {
-		std::string after_last = addr.substr(last_colon + 1);
-		if (after_last.find('.') != std::string::npos) {
-			// The part after the last colon looks like an IPv4 address
-			if (!IsValidIPv4(after_last)) {
-				return false;
-			}
-			// Replace the IPv4 portion with two valid hex groups for counting
-			addr = addr.substr(0, last_colon + 1) + "0:0";
-		}
+	if (c >= 'a' && c <= 'f') {
+		return c - 'a' + 10;
 	}
-
-	// Split by ':'
-	std::vector<std::string> parts;
-	std::string part;
-	std::istringstream stream(addr);
-	while (std::getline(stream, part, ':')) {
-		parts.push_back(part);
+	if (c >= 'A' && c <= 'F') {
+		return c - 'A' + 10;
 	}
+	return -1;
+}
 
-	// Handle leading :: (addr starts with ::)
-	if (addr.size() >= 2 && addr[0] == ':' && addr[1] == ':') {
-		parts.emplace(parts.begin(), "");
+bool ParseIPv6(std::string_view ip, std::array<uint16_t, 8> &groups) {
+	// Strip surrounding brackets if present: [::1] -> ::1
+	if (ip.size() >= 2 && ip.front() == '[' && ip.back() == ']') {
+		ip = ip.substr(1, ip.size() - 2);
 	}
-	// Handle trailing :: (addr ends with ::)
-	if (addr.size() >= 2 && addr[addr.size() - 1] == ':' && addr[addr.size() - 2] == ':') {
-		parts.emplace_back("");
+	if (ip.size() < 2) {
+		return false;
 	}
 
-	// Count double-colon occurrences
-	int double_colon_count = 0;
-	{
-		size_t pos = 0;
-		while ((pos = addr.find("::", pos)) != std::string::npos) {
-			double_colon_count++;
-			pos += 2;
+	// Groups are written in order, the ones after :: are moved to the end at last
+	int count = 0;
+	int gap = -1;
+	size_t i = 0;
+	if (ip[0] == ':') {
+		if (ip[1] != ':') {
+			return false;
 		}
+		gap = 0;
+		i = 2;
 	}
 
-	if (double_colon_count > 1) {
-		return false;
-	}
-
-	if (double_colon_count == 1) {
-		// Find where the :: is
-		int empty_count = 0;
-		for (const auto &p : parts) {
-			if (p.empty()) {
-				empty_count++;
-			}
+	while (i < ip.size()) {
+		size_t group_start = i;
+		uint32_t value = 0;
+		int digit;
+		while (i < ip.size() && (digit = HexDigit(ip[i])) >= 0) {
+			value = (value << 4) | static_cast<uint32_t>(digit);
+			++i;
 		}
 
-		// Validate non-empty parts
-		for (const auto &p : parts) {
-			if (!p.empty() && !IsValidIPv6Group(p)) {
+		// An embedded IPv4 address (e.g. ::ffff:192.168.1.1) is last and holds two groups
+		if (i < ip.size() && ip[i] == '.') {
+			uint32_t ipv4;
+			if (count > 6 || !ParseIPv4(ip.substr(group_start), ipv4)) {
 				return false;
 			}
+			groups[count++] = static_cast<uint16_t>(ipv4 >> 16);
+			groups[count++] = static_cast<uint16_t>(ipv4 & 0xFFFF);
+			break;
 		}
 
-		// With ::, we need at most 8 groups total
-		int non_empty = static_cast<int>(parts.size()) - empty_count;
-		if (non_empty > 7) {
+		size_t len = i - group_start;
+		if (len == 0 || len > 4 || count == 8) {
 			return false;
 		}
+		groups[count++] = static_cast<uint16_t>(value);
 
-		return true;
+		if (i == ip.size()) {
+			break;
+		}
+		if (ip[i] != ':' || ++i == ip.size()) {
+			return false;
+		}
+		if (ip[i] == ':') {
+			if (gap >= 0) {
+				return false;
+			}
+			gap = count;
+			++i;
+		}
 	}
 
-	// No double-colon: must have exactly 8 groups
-	if (parts.size() != 8) {
+	if (gap < 0) {
+		return count == 8;
+	}
+	// :: stands for at least one zero group
+	if (count == 8) {
 		return false;
 	}
-	for (const auto &p : parts) {
-		if (!IsValidIPv6Group(p)) {
-			return false;
-		}
+	int tail = count - gap;
+	for (int k = tail - 1; k >= 0; --k) {
+		groups[8 - tail + k] = groups[gap + k];
+	}
+	for (int k = gap; k < 8 - tail; ++k) {
+		groups[k] = 0;
 	}
-
 	return true;
 }
 
+bool IsValidIPv6(std::string_view ip) {
+	std::array<uint16_t, 8> groups;
+	return ParseIPv6(ip, groups);
+}
+
 // ---------------------------------------------------------------------------
 // IP version detection
 // ---------------------------------------------------------------------------
-int DetectIPVersion(const std::string &ip) {
-	if (ip.empty()) {
-		return 0;
-	}
-
+int DetectIPVersion(std::string_view ip) {
 	// If it contains ':', it's potentially IPv6
-	if (ip.find(':') != std::string::npos) {
+	if (ip.find(':') != std::string_view::npos) {
 		return IsValidIPv6(ip) ? 6 : 0;
 	}
 
@@ -196,21 +177,9 @@ int DetectIPVersion(const std::string &ip) {
 // ---------------------------------------------------------------------------
 // IPv4 <-> integer conversion
 // ---------------------------------------------------------------------------
-uint32_t IPv4ToUint32(const std::string &ip) {
+uint32_t IPv4ToUint32(std::string_view ip) {
 	uint32_t result = 0;
-	int shift = 24;
-	int octet_start = 0;
-
-	for (size_t i = 0; i <= ip.size(); ++i) {
-		if (i == ip.size() || ip[i] == '.') {
-			int val = 0;
-			std::from_chars(ip.data() + octet_start, ip.data() + i, val);
-			result |= (static_cast<uint32_t>(val) << shift);
-			shift -= 8;
-			octet_start = static_cast<int>(i) + 1;
-		}
-	}
-
+	ParseIPv4(ip, result);
 	return result;
 }
 
@@ -222,9 +191,11 @@ std::string Uint32ToIPv4(uint32_t ip) {
 // ---------------------------------------------------------------------------
 // Private/reserved IPv4 range check
 // ---------------------------------------------------------------------------
-bool IsPrivateIPv4(const std::string &ip) {
-	uint32_t addr = IPv4ToUint32(ip);
+bool IsPrivateIPv4(std::string_view ip) {
+	return IsPrivateIPv4(IPv4ToUint32(ip));
+}
 
+bool IsPrivateIPv4(uint32_t addr) {
 	// 10.0.0.0/8 (10.0.0.0 - 10.255.255.255) - RFC 1918
 	if ((addr & 0xFF000000) == 0x0A000000) {
 		return true;
@@ -306,72 +277,13 @@ bool IsPrivateIPv4(const std::string &ip) {
 // ---------------------------------------------------------------------------
 // Private/reserved IPv6 range check
 // ---------------------------------------------------------------------------
-static std::array<uint16_t, 8> ParseIPv6Groups(const std::string &ip) {
+bool IsPrivateIPv6(std::string_view ip) {
 	std::array<uint16_t, 8> groups {};
-	std::string addr = ip;
-
-	// Strip brackets
-	if (addr.front() == '[' && addr.back() == ']') {
-		addr = addr.substr(1, addr.size() - 2);
-	}
-
-	// Handle :: expansion
-	size_t dc_pos = addr.find("::");
-	std::vector<std::string> left_parts;
-	std::vector<std::string> right_parts;
-
-	if (dc_pos != std::string::npos) {
-		std::string left = addr.substr(0, dc_pos);
-		std::string right = addr.substr(dc_pos + 2);
-
-		if (!left.empty()) {
-			std::istringstream ls(left);
-			std::string p;
-			while (std::getline(ls, p, ':')) {
-				left_parts.push_back(p);
-			}
-		}
-		if (!right.empty()) {
-			std::istringstream rs(right);
-			std::string p;
-			while (std::getline(rs, p, ':')) {
-				right_parts.push_back(p);
-			}
-		}
-
-		size_t left_count = left_parts.size();
-		size_t right_count = right_parts.size();
-		size_t zeros_needed = 8 - left_count - right_count;
-
-		size_t idx = 0;
-		for (size_t i = 0; i < left_count; ++i) {
-			groups[idx] = static_cast<uint16_t>(std::stoul(left_parts[i], nullptr, 16));
-			++idx;
-		}
-		for (size_t i = 0; i < zeros_needed; ++i) {
-			groups[idx] = 0;
-			++idx;
-		}
-		for (size_t i = 0; i < right_count; ++i) {
-			groups[idx] = static_cast<uint16_t>(std::stoul(right_parts[i], nullptr, 16));
-			++idx;
-		}
-	} else {
-		std::istringstream stream(addr);
-		std::string part;
-		int idx = 0;
-		while (std::getline(stream, part, ':') && idx < 8) {
-			groups[idx] = static_cast<uint16_t>(std::stoul(part, nullptr, 16));
-			++idx;
-		}
-	}
-
-	return groups;
+	ParseIPv6(ip, groups);
+	return IsPrivateIPv6(groups);
 }
 
-bool IsPrivateIPv6(const std::string &ip) {
-	auto groups = ParseIPv6Groups(ip);
-
+bool IsPrivateIPv6(const std::array<uint16_t, 8> &groups) {
 	// ::1 - Loopback
 	if (groups[0] == 0 && groups[1] == 0 && groups[2] == 0 && groups[3] == 0 && groups[4] == 0 && groups[5] == 0 &&
 	    groups[6] == 0 && groups[7] == 1) {
@@ -409,8 +321,7 @@ bool IsPrivateIPv6(const std::string &ip) {
 	if (groups[0] == 0 && groups[1] == 0 && groups[2] == 0 && groups[3] == 0 && groups[4] == 0 && groups[5] == 0xFFFF) {
 		// Reconstruct the IPv4 address and check if it's private
 		uint32_t ipv4 = (static_cast<uint32_t>(groups[6]) << 16) | static_cast<uint32_t>(groups[7]);
-		std::string ipv4_str = Uint32ToIPv4(ipv4);
-		return IsPrivateIPv4(ipv4_str);
+		return IsPrivateIPv4(ipv4);
 	}
 
 	// 2001:db8::/32 - Documentation
@@ -426,122 +337,205 @@ bool IsPrivateIPv6(const std::string &ip) {
 	return false;
 }
 
-} // namespace netquack
-
-// ===========================================================================
-// DuckDB Scalar Function implementations
-// ===========================================================================
-
-void IsValidIPFunction(DataChunk &args, ExpressionState &, Vector &result) {
-	const auto &input_vector = args.data[0];
-	auto result_data = FlatVector::GetData<bool>(result);
-	auto &result_validity = FlatVector::Validity(result);
-
-	for (idx_t i = 0; i < args.size(); i++) {
-		auto value = input_vector.GetValue(i);
-		if (value.IsNull()) {
-			result_validity.SetInvalid(i);
-			continue;
+// ---------------------------------------------------------------------------
+// IP addresses as 128-bit numbers
+// ---------------------------------------------------------------------------
+bool ParseIPAddress(std::string_view ip, uhugeint_t &address) {
+	if (ip.find(':') != std::string_view::npos) {
+		std::array<uint16_t, 8> groups;
+		if (!ParseIPv6(ip, groups)) {
+			return false;
 		}
+		address = IPv6Address(groups);
+		return true;
+	}
+	uint32_t ipv4;
+	if (!ParseIPv4(ip, ipv4)) {
+		return false;
+	}
+	address = IPv4Address(ipv4);
+	return true;
+}
 
-		auto input = value.ToString();
-		result_data[i] = netquack::IsValidIPv4(input) || netquack::IsValidIPv6(input);
+uhugeint_t IPv6Address(const std::array<uint16_t, 8> &groups) {
+	uhugeint_t address;
+	address.upper = 0;
+	address.lower = 0;
+	for (int i = 0; i < 4; i++) {
+		address.upper = (address.upper << 16) | groups[i];
+		address.lower = (address.lower << 16) | groups[i + 4];
 	}
+	return address;
 }
 
-void IsPrivateIPFunction(DataChunk &args, ExpressionState &, Vector &result) {
-	const auto &input_vector = args.data[0];
-	auto result_data = FlatVector::GetData<bool>(result);
-	auto &result_validity = FlatVector::Validity(result);
-
-	for (idx_t i = 0; i < args.size(); i++) {
-		auto value = input_vector.GetValue(i);
-		if (value.IsNull()) {
-			result_validity.SetInvalid(i);
-			continue;
-		}
+std::array<uint16_t, 8> IPv6Groups(uhugeint_t address) {
+	std::array<uint16_t, 8> groups {};
+	for (int i = 0; i < 4; i++) {
+		groups[i] = static_cast<uint16_t>(address.upper >> (48 - 16 * i));
+		groups[i + 4] = static_cast<uint16_t>(address.lower >> (48 - 16 * i));
+	}
+	return groups;
+}
+
+bool ParseIPRange(std::string_view cidr, IPRange &range) {
+	auto slash = cidr.find('/');
+	auto host = cidr.substr(0, slash);
+	uhugeint_t address;
+	if (!ParseIPAddress(host, address)) {
+		return false;
+	}
+	// An IPv4 block counts its prefix within 32 bits, even when written IPv4-mapped
+	int max_length = host.find(':') == std::string_view::npos ? 32 : 128;
 
-		auto input = value.ToString();
-		int version = netquack::DetectIPVersion(input);
-		if (version == 4) {
-			result_data[i] = netquack::IsPrivateIPv4(input);
-		} else if (version == 6) {
-			result_data[i] = netquack::IsPrivateIPv6(input);
-		} else {
-			// Invalid IP: return NULL
-			result_validity.SetInvalid(i);
+	int length = max_length;
+	if (slash != std::string_view::npos) {
+		auto first = cidr.data() + slash + 1;
+		auto last = cidr.data() + cidr.size();
+		// from_chars accepts a sign, the prefix length is digits only
+		if (first == last || last - first > 3 || *first < '0' || *first > '9') {
+			return false;
+		}
+		auto parsed = std::from_chars(first, last, length);
+		if (parsed.ec != std::errc() || parsed.ptr != last || length > max_length) {
+			return false;
 		}
 	}
+	length += 128 - max_length;
+
+	range.prefix_length = static_cast<uint8_t>(length);
+	range.mask.upper = length >= 64 ? ~0ULL : length == 0 ? 0 : ~0ULL << (64 - length);
+	range.mask.lower = length <= 64 ? 0 : ~0ULL << (128 - length);
+	range.network.upper = address.upper & range.mask.upper;
+	range.network.lower = address.lower & range.mask.lower;
+	return true;
 }
 
-void IPToIntFunction(DataChunk &args, ExpressionState &, Vector &result) {
-	const auto &input_vector = args.data[0];
-	auto result_data = FlatVector::GetData<uint64_t>(result);
-	auto &result_validity = FlatVector::Validity(result);
-
-	for (idx_t i = 0; i < args.size(); i++) {
-		auto value = input_vector.GetValue(i);
-		if (value.IsNull()) {
-			result_validity.SetInvalid(i);
+std::string FormatIPAddress(uhugeint_t address) {
+	if (IsIPv4Address(address)) {
+		return Uint32ToIPv4(static_cast<uint32_t>(address.lower));
+	}
+
+	// RFC 5952: the longest run of two or more zero groups, the first one on a tie, is written as ::
+	auto groups = IPv6Groups(address);
+	int run_start = -1;
+	int run_length = 1;
+	for (int i = 0; i < 8;) {
+		if (groups[i] != 0) {
+			++i;
 			continue;
 		}
+		int j = i;
+		while (j < 8 && groups[j] == 0) {
+			++j;
+		}
+		if (j - i > run_length) {
+			run_start = i;
+			run_length = j - i;
+		}
+		i = j;
+	}
 
-		auto input = value.ToString();
-		if (!netquack::IsValidIPv4(input)) {
-			// Only support IPv4 for integer conversion (IPv6 needs HUGEINT)
-			result_validity.SetInvalid(i);
+	static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+	std::string text;
+	for (int i = 0; i < 8; i++) {
+		if (i == run_start) {
+			text += "::";
+			i += run_length - 1;
 			continue;
 		}
-
-		result_data[i] = static_cast<uint64_t>(netquack::IPv4ToUint32(input));
+		if (!text.empty() && text.back() != ':') {
+			text += ':';
+		}
+		bool leading = true;
+		for (int shift = 12; shift >= 0; shift -= 4) {
+			auto digit = (groups[i] >> shift) & 0xF;
+			if (digit != 0 || !leading || shift == 0) {
+				text += HEX_DIGITS[digit];
+				leading = false;
+			}
+		}
 	}
+	return text;
 }
 
-void IntToIPFunction(DataChunk &args, ExpressionState &, Vector &result) {
-	const auto &input_vector = args.data[0];
-	auto result_data = FlatVector::GetData<string_t>(result);
-	auto &result_validity = FlatVector::Validity(result);
-
-	for (idx_t i = 0; i < args.size(); i++) {
-		auto value = input_vector.GetValue(i);
-		if (value.IsNull()) {
-			result_validity.SetInvalid(i);
-			continue;
-		}
+} // namespace netquack
 
-		uint64_t int_val = value.GetValue<uint64_t>();
-		if (int_val > 0xFFFFFFFF) {
-			// Out of IPv4 range
-			result_validity.SetInvalid(i);
-			continue;
-		}
+// ===========================================================================
+// DuckDB Scalar Function implementations
+// ===========================================================================
 
-		auto ip_str = netquack::Uint32ToIPv4(static_cast<uint32_t>(int_val));
-		result_data[i] = StringVector::AddString(result, ip_str);
-	}
+void IsValidIPFunction(DataChunk &args, ExpressionState &, Vector &result) {
+	auto &input_vector = args.data[0];
+
+	netquack::ExecuteUnary<string_t, bool>(input_vector, result, args.size(), [&](string_t value, Vector &) {
+		return netquack::DetectIPVersion(std::string_view(value.GetData(), value.GetSize())) != 0;
+	});
 }
 
-void IPVersionFunction(DataChunk &args, ExpressionState &, Vector &result) {
-	const auto &input_vector = args.data[0];
-	auto result_data = FlatVector::GetData<int8_t>(result);
-	auto &result_validity = FlatVector::Validity(result);
-
-	for (idx_t i = 0; i < args.size(); i++) {
-		auto value = input_vector.GetValue(i);
-		if (value.IsNull()) {
-			result_validity.SetInvalid(i);
-			continue;
-		}
+void IsPrivateIPFunction(DataChunk &args, ExpressionState &, Vector &result) {
+	auto &input_vector = args.data[0];
+
+	netquack::ExecuteUnaryWithNulls<string_t, bool>(
+	    input_vector, result, args.size(), [&](string_t value, ValidityMask &mask, idx_t idx, Vector &) {
+		    std::string_view input(value.GetData(), value.GetSize());
+		    uint32_t ipv4;
+		    if (netquack::ParseIPv4(input, ipv4)) {
+			    return netquack::IsPrivateIPv4(ipv4);
+		    }
+		    std::array<uint16_t, 8> groups;
+		    if (netquack::ParseIPv6(input, groups)) {
+			    return netquack::IsPrivateIPv6(groups);
+		    }
+		    // Invalid IP: return NULL
+		    mask.SetInvalid(idx);
+		    return false;
+	    });
+}
 
-		auto input = value.ToString();
-		int version = netquack::DetectIPVersion(input);
-		if (version == 0) {
-			// Invalid IP: return NULL
-			result_validity.SetInvalid(i);
-		} else {
-			result_data[i] = static_cast<int8_t>(version);
-		}
-	}
+void IPToIntFunction(DataChunk &args, ExpressionState &, Vector &result) {
+	auto &input_vector = args.data[0];
+
+	netquack::ExecuteUnaryWithNulls<string_t, uint64_t>(
+	    input_vector, result, args.size(), [&](string_t value, ValidityMask &mask, idx_t idx, Vector &) {
+		    uint32_t ipv4;
+		    if (!netquack::ParseIPv4(std::string_view(value.GetData(), value.GetSize()), ipv4)) {
+			    // Only support IPv4 for integer conversion (IPv6 needs HUGEINT)
+			    mask.SetInvalid(idx);
+			    return uint64_t(0);
+		    }
+
+		    return static_cast<uint64_t>(ipv4);
+	    });
+}
+
+void IntToIPFunction(DataChunk &args, ExpressionState &, Vector &result) {
+	auto &input_vector = args.data[0];
+
+	netquack::ExecuteUnaryWithNulls<uint64_t, string_t>(
+	    input_vector, result, args.size(), [&](uint64_t int_val, ValidityMask &mask, idx_t idx, Vector &target) {
+		    if (int_val > 0xFFFFFFFF) {
+			    // Out of IPv4 range
+			    mask.SetInvalid(idx);
+			    return string_t();
+		    }
+
+		    auto ip_str = netquack::Uint32ToIPv4(static_cast<uint32_t>(int_val));
+		    return StringVector::AddString(target, ip_str);
+	    });
+}
+
+void IPVersionFunction(DataChunk &args, ExpressionState &, Vector &result) {
+	auto &input_vector = args.data[0];
+
+	netquack::ExecuteUnaryWithNulls<string_t, int8_t>(
+	    input_vector, result, args.size(), [&](string_t value, ValidityMask &mask, idx_t idx, Vector &) {
+		    int version = netquack::DetectIPVersion(std::string_view(value.GetData(), value.GetSize()));
+		    if (version == 0) {
+			    // Invalid IP: return NULL
+			    mask.SetInvalid(idx);
+		    }
+		    return static_cast<int8_t>(version);
+	    });
 }
 
 } // namespace duckdb
@@ -2,6 +2,9 @@
 
 #pragma once
 
+#include <array>
+#include <string_view>
+
 #include "duckdb.hpp"
 
 namespace duckdb {
@@ -21,30 +24,80 @@ void IntToIPFunction(DataChunk &args, ExpressionState &state, Vector &result);
 void IPVersionFunction(DataChunk &args, ExpressionState &state, Vector &result);
 
 namespace netquack {
+// Parse a dotted-quad IPv4 address in one pass, false if it is not valid
+bool ParseIPv4(std::string_view ip, uint32_t &address);
+
+// Parse an IPv6 address into its 8 groups in one pass without allocating, false if it is not valid.
+// Handles surrounding brackets, :: and an embedded IPv4 address such as ::ffff:192.168.1.1.
+bool ParseIPv6(std::string_view ip, std::array<uint16_t, 8> &groups);
+
 // Check if a string is a valid IPv4 address
-bool IsValidIPv4(const std::string &ip);
+bool IsValidIPv4(std::string_view ip);
 
 // Check if a string is a valid IPv6 address
-bool IsValidIPv6(const std::string &ip);
+bool IsValidIPv6(std::string_view ip);
 
 // Check if an IPv4 address is in a private/reserved range
-bool IsPrivateIPv4(const std::string &ip);
+bool IsPrivateIPv4(std::string_view ip);
+bool IsPrivateIPv4(uint32_t addr);
 
 // Check if an IPv6 address is in a private/reserved range
-bool IsPrivateIPv6(const std::string &ip);
+bool IsPrivateIPv6(std::string_view ip);
+bool IsPrivateIPv6(const std::array<uint16_t, 8> &groups);
 
-// Convert IPv4 address to 32-bit integer
-uint32_t IPv4ToInt(const std::string &ip);
-
-// Convert IPv6 address to 128-bit integer (returned as high and low 64-bit parts)
-// For simplicity we return the full 128 bits as a __uint128_t or two uint64_t
-// DuckDB HUGEINT can hold 128-bit values, but we use UBIGINT for IPv4 only
-uint32_t IPv4ToUint32(const std::string &ip);
+// Convert IPv4 address to 32-bit integer, 0 if it is invalid
+uint32_t IPv4ToUint32(std::string_view ip);
 
 // Convert 32-bit integer to IPv4 address
 std::string Uint32ToIPv4(uint32_t ip);
 
 // Detect IP version: returns 4, 6, or 0 (invalid)
-int DetectIPVersion(const std::string &ip);
+int DetectIPVersion(std::string_view ip);
+
+// An IP address as a 128-bit number, the value of the IP type. IPv4 addresses are stored IPv4-mapped
+// (::ffff:a.b.c.d), which tags their family and keeps them in one contiguous range.
+inline uhugeint_t IPv4Address(uint32_t ip) {
+	uhugeint_t address;
+	address.upper = 0;
+	address.lower = 0xFFFF00000000ULL | ip;
+	return address;
+}
+inline bool IsIPv4Address(uhugeint_t address) {
+	return address.upper == 0 && (address.lower >> 32) == 0xFFFF;
+}
+uhugeint_t IPv6Address(const std::array<uint16_t, 8> &groups);
+std::array<uint16_t, 8> IPv6Groups(uhugeint_t address);
+
+// Parse an IPv4 or IPv6 address, false if it is not valid
+bool ParseIPAddress(std::string_view ip, uhugeint_t &address);
+
+// Address of an argument of an IP function, either VARCHAR or IP
+inline bool ToIPAddress(string_t input, uhugeint_t &address) {
+	return ParseIPAddress(std::string_view(input.GetData(), input.GetSize()), address);
+}
+inline bool ToIPAddress(uhugeint_t input, uhugeint_t &address) {
+	address = input;
+	return true;
+}
+
+// IPv4 addresses in dotted notation, IPv6 addresses in the canonical form of RFC 5952
+std::string FormatIPAddress(uhugeint_t address);
+
+// A CIDR block over the addresses of the IP type. The IPv4 block a.b.c.d/n covers ::ffff:a.b.c.d/(96 + n).
+struct IPRange {
+	uhugeint_t network;
+	uhugeint_t mask;
+	// Length of the prefix within the 128 bits
+	uint8_t prefix_length;
+
+	// Without branches, so loops over a chunk can be vectorized
+	bool Contains(uhugeint_t address) const {
+		return ((address.upper & mask.upper) == network.upper) & ((address.lower & mask.lower) == network.lower);
+	}
+};
+
+// Parse a CIDR block such as 10.0.0.0/8 or 2001:db8::/32, false if it is not valid. Host bits are cleared and an
+// address without a prefix length is a block of one address.
+bool ParseIPRange(std::string_view cidr, IPRange &range);
 } // namespace netquack
 } // namespace duckdb
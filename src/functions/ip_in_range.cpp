@@ -0,0 +1,67 @@
+// Copyright 2026 Arash Hatami
+
+#include "ip_in_range.hpp"
+
+namespace duckdb::netquack {
+namespace {
+template <class INPUT_TYPE>
+void CheckIPRange(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &info = state.expr.Cast<BoundFunctionExpression>().bind_info->Cast<IPInRangeData>();
+	auto &input = args.data[0];
+	auto count = args.size();
+
+	if (!info.constant) {
+		// The block can change from row to row, parse it every time
+		BinaryExecutor::ExecuteWithNulls<INPUT_TYPE, string_t, bool>(
+		    input, args.data[1], result, count, [&](INPUT_TYPE ip, string_t cidr, ValidityMask &mask, idx_t idx) {
+			    uhugeint_t address;
+			    IPRange range;
+			    if (!ToIPAddress(ip, address) ||
+			        !ParseIPRange(std::string_view(cidr.GetData(), cidr.GetSize()), range)) {
+				    mask.SetInvalid(idx);
+				    return false;
+			    }
+			    return range.Contains(address);
+		    });
+		return;
+	}
+	if (!info.valid) {
+		result.SetVectorType(VectorType::CONSTANT_VECTOR);
+		ConstantVector::SetNull(result, true);
+		return;
+	}
+
+	// Only the address is converted per row, the compare is a masked compare of two words
+	auto range = info.range;
+	UnaryExecutor::ExecuteWithNulls<INPUT_TYPE, bool>(
+	    input, result, count, [&](INPUT_TYPE ip, ValidityMask &mask, idx_t idx) {
+		    uhugeint_t address;
+		    if (!ToIPAddress(ip, address)) {
+			    mask.SetInvalid(idx);
+			    return false;
+		    }
+		    return range.Contains(address);
+	    });
+}
+} // namespace
+
+unique_ptr<FunctionData> BindIPInRangeFunction(ClientContext &context, ScalarFunction &,
+                                               vector<unique_ptr<Expression>> &arguments) {
+	auto data = make_uniq<IPInRangeData>();
+	if (!arguments[1]->IsFoldable()) {
+		return std::move(data);
+	}
+	data->constant = true;
+	auto cidr = ExpressionExecutor::EvaluateScalar(context, *arguments[1]);
+	data->valid = !cidr.IsNull() && ParseIPRange(cidr.GetValue<std::string>(), data->range);
+	return std::move(data);
+}
+
+void IPInRangeFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	CheckIPRange<string_t>(args, state, result);
+}
+
+void IPAddressInRangeFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	CheckIPRange<uhugeint_t>(args, state, result);
+}
+} // namespace duckdb::netquack
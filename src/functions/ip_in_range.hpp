@@ -0,0 +1,37 @@
+// Copyright 2026 Arash Hatami
+
+#pragma once
+
+#include "duckdb.hpp"
+#include "ip_functions.hpp"
+
+namespace duckdb::netquack {
+// Bind data of ip_in_range, holds the CIDR block when it is a constant
+struct IPInRangeData : public FunctionData {
+	IPInRangeData() = default;
+
+	bool constant = false;
+	// Whether the constant CIDR block is valid, every row is NULL otherwise
+	bool valid = false;
+	IPRange range {};
+
+	unique_ptr<FunctionData> Copy() const override {
+		return make_uniq<IPInRangeData>(*this);
+	}
+	bool Equals(const FunctionData &other) const override {
+		auto &other_data = other.Cast<IPInRangeData>();
+		return constant == other_data.constant && valid == other_data.valid &&
+		       range.prefix_length == other_data.range.prefix_length && range.network == other_data.range.network;
+	}
+};
+
+// Parses a constant CIDR argument once
+unique_ptr<FunctionData> BindIPInRangeFunction(ClientContext &context, ScalarFunction &bound_function,
+                                               vector<unique_ptr<Expression>> &arguments);
+
+// Scalar function: ip_in_range(VARCHAR, VARCHAR) -> BOOLEAN
+void IPInRangeFunction(DataChunk &args, ExpressionState &state, Vector &result);
+
+// Scalar function: ip_in_range(IP, VARCHAR) -> BOOLEAN
+void IPAddressInRangeFunction(DataChunk &args, ExpressionState &state, Vector &result);
+} // namespace duckdb::netquack
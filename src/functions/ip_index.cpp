@@ -0,0 +1,125 @@
+// Copyright 2026 Arash Hatami
+
+#include "ip_index.hpp"
+
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "../utils/logger.hpp"
+#include "../utils/table_scan.hpp"
+#include "../utils/utils.hpp"
+
+namespace duckdb::netquack {
+namespace {
+std::string argumentString(Vector &vector, const char *description) {
+	auto value = vector.GetValue(0);
+	if (value.IsNull() || value.GetValue<std::string>().empty()) {
+		LogMessage(LogLevel::LOG_CRITICAL, std::string("The ") + description + " must not be empty");
+	}
+	return value.GetValue<std::string>();
+}
+
+void addBlocks(IPPrefixIndex::Builder &builder, DataChunk &chunk, idx_t &invalid_count) {
+	UnifiedVectorFormat cidrs;
+	UnifiedVectorFormat payloads;
+	chunk.data[0].ToUnifiedFormat(chunk.size(), cidrs);
+	chunk.data[1].ToUnifiedFormat(chunk.size(), payloads);
+	auto cidr_data = UnifiedVectorFormat::GetData<string_t>(cidrs);
+	auto payload_data = UnifiedVectorFormat::GetData<string_t>(payloads);
+	for (idx_t i = 0; i < chunk.size(); ++i) {
+		auto cidr_index = cidrs.sel->get_index(i);
+		auto payload_index = payloads.sel->get_index(i);
+		if (!cidrs.validity.RowIsValid(cidr_index) || !payloads.validity.RowIsValid(payload_index)) {
+			continue;
+		}
+		IPRange range;
+		if (!ParseIPRange(cidr_data[cidr_index].GetString(), range)) {
+			++invalid_count;
+			continue;
+		}
+		builder.add(range, payload_data[payload_index].GetString());
+	}
+}
+
+template <class INPUT_TYPE>
+void LookupPayloads(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &index = *IPIndexLocalState::Get(state).index;
+	UnaryExecutor::ExecuteWithNulls<INPUT_TYPE, string_t>(
+	    args.data[1], result, args.size(), [&](INPUT_TYPE ip, ValidityMask &mask, idx_t idx) {
+		    uhugeint_t address;
+		    const std::string *payload = ToIPAddress(ip, address) ? index.lookup(address) : nullptr;
+		    if (!payload) {
+			    // Invalid address or no block contains it
+			    mask.SetInvalid(idx);
+			    return string_t();
+		    }
+		    return StringVector::AddString(result, *payload);
+	    });
+}
+} // namespace
+
+void CreateIPIndexFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto name = argumentString(args.data[0], "IP index name");
+	auto table_name = argumentString(args.data[1], "table name");
+	auto cidr_column = argumentString(args.data[2], "CIDR column");
+	auto payload_column = argumentString(args.data[3], "payload column");
+
+	auto &context = state.GetContext();
+	auto table = Catalog::GetEntry<TableCatalogEntry>(context, INVALID_CATALOG, INVALID_SCHEMA, table_name,
+	                                                  OnEntryNotFound::RETURN_NULL);
+	if (!table) {
+		LogMessage(LogLevel::LOG_CRITICAL, "Table `" + table_name + "` not found");
+	}
+
+	// Read in the transaction of the query, so rows it has not committed yet are indexed too
+	IPPrefixIndex::Builder builder;
+	idx_t invalid_count = 0;
+	ScanTable(context, *table, {cidr_column, payload_column}, {LogicalType::VARCHAR, LogicalType::VARCHAR},
+	          [&](DataChunk &chunk) { addBlocks(builder, chunk, invalid_count); });
+	if (invalid_count > 0) {
+		LogMessage(LogLevel::LOG_WARNING, "Skipped " + std::to_string(invalid_count) + " invalid CIDR blocks of `" +
+		                                      table_name + "`");
+	}
+
+	auto index = builder.build();
+	auto block_count = index->size();
+	IPPrefixIndex::publish(*context.db, name, std::move(index));
+	result.SetValue(0, Value::UBIGINT(block_count));
+}
+
+unique_ptr<FunctionData> BindIPLookupFunction(ClientContext &context, ScalarFunction &,
+                                              vector<unique_ptr<Expression>> &arguments) {
+	// The index is pinned once per query, so it has to be known before the first row
+	if (!arguments[0]->IsFoldable()) {
+		LogMessage(LogLevel::LOG_CRITICAL, "The IP index name must be a constant");
+	}
+	auto name = ExpressionExecutor::EvaluateScalar(context, *arguments[0]);
+	if (name.IsNull()) {
+		LogMessage(LogLevel::LOG_CRITICAL, "The IP index name must not be NULL");
+	}
+	return make_uniq<IPLookupData>(name.GetValue<std::string>());
+}
+
+unique_ptr<FunctionLocalState> IPIndexLocalState::Init(ExpressionState &state, const BoundFunctionExpression &,
+                                                       FunctionData *bind_data) {
+	auto &name = bind_data->Cast<IPLookupData>().name;
+	auto index = IPPrefixIndex::get(*state.GetContext().db, name);
+	if (!index) {
+		LogMessage(LogLevel::LOG_CRITICAL, "IP index `" + name +
+		                                       "` not found. Create it first using `SELECT create_ip_index('" + name +
+		                                       "', table, cidr_column, payload_column);`");
+	}
+	return make_uniq<IPIndexLocalState>(std::move(index));
+}
+
+IPIndexLocalState &IPIndexLocalState::Get(ExpressionState &state) {
+	return ExecuteFunctionState::GetFunctionState(state)->Cast<IPIndexLocalState>();
+}
+
+void IPLookupFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	LookupPayloads<string_t>(args, state, result);
+}
+
+void IPAddressLookupFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	LookupPayloads<uhugeint_t>(args, state, result);
+}
+} // namespace duckdb::netquack
@@ -0,0 +1,50 @@
+// Copyright 2026 Arash Hatami
+
+#pragma once
+
+#include "duckdb.hpp"
+#include "../utils/ip_prefix_index.hpp"
+
+namespace duckdb::netquack {
+// Scalar function: create_ip_index(VARCHAR name, VARCHAR table, VARCHAR cidr_column, VARCHAR payload_column) -> UBIGINT
+// Builds the index from the current rows of the table and returns the number of blocks in it
+void CreateIPIndexFunction(DataChunk &args, ExpressionState &state, Vector &result);
+
+// Bind data of ip_lookup, the constant index name
+struct IPLookupData : public FunctionData {
+	explicit IPLookupData(std::string name) : name(std::move(name)) {
+	}
+
+	std::string name;
+
+	unique_ptr<FunctionData> Copy() const override {
+		return make_uniq<IPLookupData>(name);
+	}
+	bool Equals(const FunctionData &other) const override {
+		return name == other.Cast<IPLookupData>().name;
+	}
+};
+
+// Reads the constant index name argument
+unique_ptr<FunctionData> BindIPLookupFunction(ClientContext &context, ScalarFunction &bound_function,
+                                              vector<unique_ptr<Expression>> &arguments);
+
+// Function local state of ip_lookup, pins one index for the whole query
+struct IPIndexLocalState : public FunctionLocalState {
+	explicit IPIndexLocalState(std::shared_ptr<const IPPrefixIndex> index) : index(std::move(index)) {
+	}
+
+	std::shared_ptr<const IPPrefixIndex> index;
+
+	// Fails when there is no index of that name
+	static unique_ptr<FunctionLocalState> Init(ExpressionState &state, const BoundFunctionExpression &expr,
+	                                           FunctionData *bind_data);
+	static IPIndexLocalState &Get(ExpressionState &state);
+};
+
+// Scalar function: ip_lookup(VARCHAR name, VARCHAR ip) -> VARCHAR
+void IPLookupFunction(DataChunk &args, ExpressionState &state, Vector &result);
+
+// Scalar function: ip_lookup(VARCHAR name, IP ip) -> VARCHAR
+void IPAddressLookupFunction(DataChunk &args, ExpressionState &state, Vector &result);
+} // namespace duckdb::netquack
@@ -0,0 +1,69 @@
+// Copyright 2026 Arash Hatami
+
+#include "ip_type.hpp"
+
+#include "duckdb/common/operator/cast_operators.hpp"
+#include "ip_functions.hpp"
+
+namespace duckdb::netquack {
+LogicalType IPType() {
+	auto type = LogicalType(LogicalTypeId::UHUGEINT);
+	type.SetAlias("IP");
+	return type;
+}
+
+bool CastVarcharToIP(Vector &source, Vector &result, idx_t count, CastParameters &parameters) {
+	bool success = true;
+	UnaryExecutor::ExecuteWithNulls<string_t, uhugeint_t>(
+	    source, result, count, [&](string_t input, ValidityMask &mask, idx_t idx) {
+		    uhugeint_t address;
+		    if (!ToIPAddress(input, address)) {
+			    HandleCastError::AssignError("Invalid IP address: '" + input.GetString() + "'", parameters);
+			    mask.SetInvalid(idx);
+			    success = false;
+			    return uhugeint_t();
+		    }
+		    return address;
+	    });
+	return success;
+}
+
+bool CastIPToVarchar(Vector &source, Vector &result, idx_t count, CastParameters &) {
+	UnaryExecutor::Execute<uhugeint_t, string_t>(source, result, count, [&](uhugeint_t address) {
+		return StringVector::AddString(result, FormatIPAddress(address));
+	});
+	return true;
+}
+
+void IsValidIPAddressFunction(DataChunk &args, ExpressionState &, Vector &result) {
+	// Every value of the type is a valid address
+	UnaryExecutor::Execute<uhugeint_t, bool>(args.data[0], result, args.size(), [](uhugeint_t) { return true; });
+}
+
+void IsPrivateIPAddressFunction(DataChunk &args, ExpressionState &, Vector &result) {
+	UnaryExecutor::Execute<uhugeint_t, bool>(args.data[0], result, args.size(), [](uhugeint_t address) {
+		if (IsIPv4Address(address)) {
+			return IsPrivateIPv4(static_cast<uint32_t>(address.lower));
+		}
+		return IsPrivateIPv6(IPv6Groups(address));
+	});
+}
+
+void IPAddressToIntFunction(DataChunk &args, ExpressionState &, Vector &result) {
+	UnaryExecutor::ExecuteWithNulls<uhugeint_t, uint64_t>(
+	    args.data[0], result, args.size(), [](uhugeint_t address, ValidityMask &mask, idx_t idx) {
+		    if (!IsIPv4Address(address)) {
+			    // Only IPv4 fits the integer result
+			    mask.SetInvalid(idx);
+			    return uint64_t(0);
+		    }
+		    return address.lower & 0xFFFFFFFF;
+	    });
+}
+
+void IPAddressVersionFunction(DataChunk &args, ExpressionState &, Vector &result) {
+	UnaryExecutor::Execute<uhugeint_t, int8_t>(args.data[0], result, args.size(), [](uhugeint_t address) {
+		return static_cast<int8_t>(IsIPv4Address(address) ? 4 : 6);
+	});
+}
+} // namespace duckdb::netquack
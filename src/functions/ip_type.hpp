@@ -0,0 +1,21 @@
+// Copyright 2026 Arash Hatami
+
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb::netquack {
+// The IP type: a UHUGEINT holding the address as a 128-bit number, see IPv4Address in ip_functions.hpp.
+// Addresses compare, sort, hash and join as integers and take 16 bytes instead of a string.
+LogicalType IPType();
+
+// Casts between VARCHAR and IP
+bool CastVarcharToIP(Vector &source, Vector &result, idx_t count, CastParameters &parameters);
+bool CastIPToVarchar(Vector &source, Vector &result, idx_t count, CastParameters &parameters);
+
+// Overloads of the IP functions for the IP type, the address is already parsed
+void IsValidIPAddressFunction(DataChunk &args, ExpressionState &state, Vector &result);
+void IsPrivateIPAddressFunction(DataChunk &args, ExpressionState &state, Vector &result);
+void IPAddressToIntFunction(DataChunk &args, ExpressionState &state, Vector &result);
+void IPAddressVersionFunction(DataChunk &args, ExpressionState &state, Vector &result);
+} // namespace duckdb::netquack
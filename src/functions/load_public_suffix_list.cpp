@@ -0,0 +1,64 @@
+// Copyright 2026 Arash Hatami
+
+#include "load_public_suffix_list.hpp"
+
+#include "duckdb/common/file_system.hpp"
+#include "../utils/logger.hpp"
+#include "../utils/tld_lookup.hpp"
+#include "../utils/vector_helpers.hpp"
+
+namespace duckdb {
+void LoadPublicSuffixListFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &path_vector = args.data[0];
+	auto &context = state.GetContext();
+
+	netquack::ExecuteUnary<string_t, string_t>(path_vector, result, args.size(), [&](string_t path, Vector &target) {
+		auto rule_count = netquack::LoadPublicSuffixList(context, path.GetString());
+		return StringVector::AddString(target, "Public suffix list loaded: " + std::to_string(rule_count) + " rules");
+	});
+}
+
+void ResetPublicSuffixListFunction(DataChunk &, ExpressionState &, Vector &result) {
+	auto &builtin = netquack::PublicSuffixList::builtin();
+	netquack::PublicSuffixList::install(std::shared_ptr<const netquack::PublicSuffixList>(
+	    std::shared_ptr<const netquack::PublicSuffixList>(), &builtin));
+
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	ConstantVector::GetData<string_t>(result)[0] = StringVector::AddString(
+	    result, "Public suffix list loaded: " + std::to_string(builtin.size()) + " rules (built-in)");
+}
+
+namespace netquack {
+size_t LoadPublicSuffixList(ClientContext &context, const std::string &path) {
+	// Read through DuckDB's file system, which applies its access settings and handles remote paths
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto file = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ | FileFlags::FILE_FLAGS_NULL_IF_NOT_EXISTS);
+	if (!file) {
+		LogMessage(LogLevel::LOG_CRITICAL, "Public suffix list `" + path + "` not found.");
+	}
+
+	std::string text;
+	std::string buffer(1 << 16, '\0');
+	while (true) {
+		auto bytes_read = file->Read(&buffer[0], buffer.size());
+		if (bytes_read <= 0) {
+			break;
+		}
+		text.append(buffer, 0, static_cast<size_t>(bytes_read));
+	}
+
+	// Compile the new list completely before it becomes visible to queries
+	auto rules = PublicSuffixList::parseRules(text);
+	if (rules.empty()) {
+		LogMessage(LogLevel::LOG_CRITICAL, "No rules found in public suffix list `" + path + "`.");
+	}
+	auto list = std::make_shared<const PublicSuffixList>(rules);
+	auto rule_count = list->size();
+
+	PublicSuffixList::install(std::move(list));
+	LogMessage(LogLevel::LOG_INFO, "Loaded public suffix list `" + path + "` with " + std::to_string(rule_count) +
+	                                   " rules");
+	return rule_count;
+}
+} // namespace netquack
+} // namespace duckdb
@@ -0,0 +1,17 @@
+// Copyright 2026 Arash Hatami
+
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+// Function to replace the public suffix list used by the domain functions
+void LoadPublicSuffixListFunction(DataChunk &args, ExpressionState &state, Vector &result);
+// Function to switch the domain functions back to the built-in public suffix list
+void ResetPublicSuffixListFunction(DataChunk &args, ExpressionState &state, Vector &result);
+
+namespace netquack {
+// Compile a public_suffix_list.dat file and install it, returns the number of rules
+size_t LoadPublicSuffixList(ClientContext &context, const std::string &path);
+} // namespace netquack
+} // namespace duckdb
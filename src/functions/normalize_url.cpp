@@ -8,29 +8,17 @@
 #include <string>
 #include <vector>
 
+#include "../utils/vector_helpers.hpp"
+
 namespace duckdb {
 
 void NormalizeURLFunction(DataChunk &args, ExpressionState &, Vector &result) {
-	const auto &input_vector = args.data[0];
-	auto result_data = FlatVector::GetData<string_t>(result);
-	auto &result_validity = FlatVector::Validity(result);
-
-	for (idx_t i = 0; i < args.size(); i++) {
-		auto value = input_vector.GetValue(i);
-		if (value.IsNull()) {
-			result_validity.SetInvalid(i);
-			continue;
-		}
+	auto &input_vector = args.data[0];
 
-		auto input = value.ToString();
-		try {
-			auto normalized = netquack::NormalizeURL(input);
-			result_data[i] = StringVector::AddString(result, normalized);
-		} catch (const std::exception &) {
-			// On any parsing failure, return original input
-			result_data[i] = StringVector::AddString(result, input);
-		}
-	}
+	netquack::ExecuteUnary<string_t, string_t>(input_vector, result, args.size(), [&](string_t value, Vector &target) {
+		auto normalized = netquack::NormalizeURL(std::string_view(value.GetData(), value.GetSize()));
+		return StringVector::AddString(target, normalized);
+	});
 }
 
 namespace netquack {
@@ -0,0 +1,47 @@
+// Copyright 2026 Arash Hatami
+
+#include "parse_failure_stats.hpp"
+
+#include "../utils/parse_failures.hpp"
+
+namespace duckdb::netquack {
+struct ParseFailureStatsLocalState : public LocalTableFunctionState {
+	std::vector<ParseFailures::Total> totals;
+	idx_t offset = 0;
+};
+
+unique_ptr<FunctionData> ParseFailureStatsFunc::Bind(ClientContext &, TableFunctionBindInput &,
+                                                     vector<LogicalType> &return_types, vector<string> &names) {
+	// 0. function_name: scalar function that saw the values
+	return_types.emplace_back(LogicalType::VARCHAR);
+	names.emplace_back("function_name");
+	// 1. failures: malformed values since the extension was loaded
+	return_types.emplace_back(LogicalTypeId::UBIGINT);
+	names.emplace_back("failures");
+	return make_uniq<TableFunctionData>();
+}
+
+unique_ptr<LocalTableFunctionState> ParseFailureStatsFunc::InitLocal(ExecutionContext &, TableFunctionInitInput &,
+                                                                     GlobalTableFunctionState *) {
+	auto local_state = make_uniq<ParseFailureStatsLocalState>();
+	local_state->totals = ParseFailures::totals();
+	return std::move(local_state);
+}
+
+unique_ptr<GlobalTableFunctionState> ParseFailureStatsFunc::InitGlobal(ClientContext &, TableFunctionInitInput &) {
+	return nullptr;
+}
+
+void ParseFailureStatsFunc::Scan(ClientContext &, TableFunctionInput &data_p, DataChunk &output) {
+	auto &local_state = dynamic_cast<ParseFailureStatsLocalState &>(*data_p.local_state);
+
+	idx_t count = 0;
+	while (local_state.offset < local_state.totals.size() && count < STANDARD_VECTOR_SIZE) {
+		auto &total = local_state.totals[local_state.offset++];
+		output.data[0].SetValue(count, Value(total.function_name));
+		output.data[1].SetValue(count, Value::UBIGINT(total.failures));
+		++count;
+	}
+	output.SetCardinality(count);
+}
+} // namespace duckdb::netquack
@@ -0,0 +1,71 @@
+// Copyright 2026 Arash Hatami
+
+#include "parse_uri.hpp"
+
+#include "../utils/url_helpers.hpp"
+#include "../utils/vector_helpers.hpp"
+
+namespace duckdb {
+void ParseURIFunction(DataChunk &args, ExpressionState &, Vector &result) {
+	auto &input_vector = args.data[0];
+
+	netquack::ExecuteDistinct(input_vector, result, args.size(), [&](Vector &source, Vector &target, idx_t count) {
+		bool is_constant = source.GetVectorType() == VectorType::CONSTANT_VECTOR;
+		if (is_constant) {
+			count = 1;
+		}
+
+		UnifiedVectorFormat input_data;
+		source.ToUnifiedFormat(count, input_data);
+		auto inputs = UnifiedVectorFormat::GetData<string_t>(input_data);
+
+		// Children are filled in the order of ParseURIType
+		auto &children = StructVector::GetEntries(target);
+		string_t *component_data[6];
+		for (idx_t c = 0; c < children.size(); c++) {
+			StringVector::AddHeapReference(*children[c], source);
+			component_data[c] = FlatVector::GetData<string_t>(*children[c]);
+		}
+		auto &result_validity = FlatVector::Validity(target);
+
+		for (idx_t i = 0; i < count; i++) {
+			auto idx = input_data.sel->get_index(i);
+			if (!input_data.validity.RowIsValid(idx)) {
+				result_validity.SetInvalid(i);
+				for (auto &child : children) {
+					FlatVector::SetNull(*child, i, true);
+				}
+				continue;
+			}
+
+			auto input = inputs[idx];
+			auto url = netquack::tokenizeURL(input.GetData(), input.GetSize());
+
+			// Scheme and host are case-insensitive, the other components are returned as-is
+			component_data[0][i] = netquack::LowerStringSlice(*children[0], url.scheme);
+			component_data[1][i] = netquack::LowerStringSlice(*children[1], url.host);
+			component_data[2][i] = netquack::StringSlice(url.port);
+			component_data[3][i] = netquack::StringSlice(url.path);
+			component_data[4][i] = netquack::StringSlice(url.query);
+			component_data[5][i] = netquack::StringSlice(url.fragment);
+		}
+
+		if (is_constant) {
+			target.SetVectorType(VectorType::CONSTANT_VECTOR);
+		}
+	});
+}
+
+namespace netquack {
+LogicalType ParseURIType() {
+	child_list_t<LogicalType> children;
+	children.emplace_back("scheme", LogicalType::VARCHAR);
+	children.emplace_back("host", LogicalType::VARCHAR);
+	children.emplace_back("port", LogicalType::VARCHAR);
+	children.emplace_back("path", LogicalType::VARCHAR);
+	children.emplace_back("query", LogicalType::VARCHAR);
+	children.emplace_back("fragment", LogicalType::VARCHAR);
+	return LogicalType::STRUCT(std::move(children));
+}
+} // namespace netquack
+} // namespace duckdb
@@ -0,0 +1,15 @@
+// Copyright 2026 Arash Hatami
+
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+// Function to split a URL into all of its components in a single pass
+void ParseURIFunction(DataChunk &args, ExpressionState &state, Vector &result);
+
+namespace netquack {
+// Return type of parse_uri
+LogicalType ParseURIType();
+} // namespace netquack
+} // namespace duckdb
@@ -0,0 +1,207 @@
+// Copyright 2026 Arash Hatami
+
+#include "tranco_history.hpp"
+
+#include "../utils/logger.hpp"
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+
+namespace duckdb::netquack {
+// The history is two tables. `tranco_history_dates` has one row per recorded list. `tranco_history` has one row per
+// domain and list that the domain's rank changed on, rank 0 meaning the domain was dropped. The rank of a domain on
+// a date is the rank of its latest row up to that date, so a day costs only its churn, and DuckDB stores the rows
+// column by column with the dates run-length encoded.
+void RecordTrancoHistory(Connection &con, const std::string &date) {
+	auto run = [&](const std::string &query) {
+		auto result = con.Query(query);
+		if (result->HasError()) {
+			LogMessage(LogLevel::LOG_CRITICAL, result->GetError());
+		}
+		return result;
+	};
+
+	run("CREATE TABLE IF NOT EXISTS tranco_history_dates (list_date DATE, domains UBIGINT)");
+	run("CREATE TABLE IF NOT EXISTS tranco_history (list_date DATE, domain VARCHAR, rank INTEGER)");
+
+	LogMessage(LogLevel::LOG_INFO, "Recording Tranco list of " + date + " in the history");
+
+	// Changes are relative to the previous recorded list. A list recorded before a later one (a backfill) becomes
+	// the base of that later list, so the full list of the next date is kept to recompute its changes. It is kept in
+	// a temporary table of the loading connection, so it never shows up in the user's catalog and a failed load
+	// doesn't leave it behind.
+	std::string list_date = "DATE '" + date + "'";
+	auto next = run("SELECT min(list_date)::VARCHAR FROM tranco_history_dates WHERE list_date > " + list_date);
+	auto next_date = next->GetValue(0, 0);
+	if (!next_date.IsNull()) {
+		run("CREATE OR REPLACE TEMP TABLE netquack_tranco_history_next AS"
+		    " SELECT domain, arg_max(rank, list_date) AS rank FROM tranco_history"
+		    " WHERE list_date <= DATE '" +
+		    next_date.GetValue<std::string>() + "' GROUP BY ALL");
+	}
+
+	// A list that is loaded again replaces its changes
+	run("DELETE FROM tranco_history WHERE list_date = " + list_date);
+	run("DELETE FROM tranco_history_dates WHERE list_date = " + list_date);
+	run("INSERT INTO tranco_history"
+	    " SELECT " +
+	    list_date +
+	    ", domain, coalesce(current_list.rank, 0)"
+	    " FROM (SELECT lower(domain) AS domain, min(rank) AS rank FROM tranco_list"
+	    " WHERE domain IS NOT NULL AND rank > 0 GROUP BY ALL) current_list"
+	    " FULL OUTER JOIN (SELECT domain, arg_max(rank, list_date) AS rank FROM tranco_history"
+	    " WHERE list_date < " +
+	    list_date +
+	    " GROUP BY ALL) previous_list USING (domain)"
+	    " WHERE coalesce(current_list.rank, 0) <> coalesce(previous_list.rank, 0)");
+	run("INSERT INTO tranco_history_dates SELECT " + list_date + ", count(*) FROM tranco_list");
+
+	if (!next_date.IsNull()) {
+		// Only the next list changes, the lists after it are still relative to the one before them
+		auto next_list_date = "DATE '" + next_date.GetValue<std::string>() + "'";
+		run("DELETE FROM tranco_history WHERE list_date = " + next_list_date);
+		run("INSERT INTO tranco_history"
+		    " SELECT " +
+		    next_list_date +
+		    ", domain, coalesce(next_list.rank, 0)"
+		    " FROM netquack_tranco_history_next next_list"
+		    " FULL OUTER JOIN (SELECT domain, arg_max(rank, list_date) AS rank FROM tranco_history"
+		    " WHERE list_date < " +
+		    next_list_date +
+		    " GROUP BY ALL) previous_list USING (domain)"
+		    " WHERE coalesce(next_list.rank, 0) <> coalesce(previous_list.rank, 0)");
+		run("DROP TABLE netquack_tranco_history_next");
+	}
+}
+
+namespace {
+// Runs one query over the history through its own connection and passes its chunks on as they are produced
+struct HistoryQueryLocalState : public LocalTableFunctionState {
+	unique_ptr<Connection> con;
+	unique_ptr<QueryResult> result;
+	unique_ptr<DataChunk> chunk;
+};
+
+unique_ptr<LocalTableFunctionState> RunHistoryQuery(ClientContext &context, const std::string &query,
+                                                    vector<Value> values) {
+	auto history = Catalog::GetEntry<TableCatalogEntry>(context, INVALID_CATALOG, INVALID_SCHEMA,
+	                                                    "tranco_history_dates", OnEntryNotFound::RETURN_NULL);
+	if (!history) {
+		LogMessage(LogLevel::LOG_CRITICAL, "Tranco history not found. Record it with `SET netquack_tranco_history = "
+		                                   "true;` before `SELECT update_tranco(true);`");
+	}
+
+	auto local_state = make_uniq<HistoryQueryLocalState>();
+	local_state->con = make_uniq<Connection>(*context.db);
+	auto statement = local_state->con->Prepare(query);
+	if (statement->HasError()) {
+		LogMessage(LogLevel::LOG_CRITICAL, statement->GetError());
+	}
+	local_state->result = statement->Execute(values, true);
+	if (local_state->result->HasError()) {
+		LogMessage(LogLevel::LOG_CRITICAL, local_state->result->GetError());
+	}
+	return std::move(local_state);
+}
+
+void ScanHistoryQuery(TableFunctionInput &data_p, DataChunk &output) {
+	auto &local_state = data_p.local_state->Cast<HistoryQueryLocalState>();
+	local_state.chunk = local_state.result->Fetch();
+	if (!local_state.chunk) {
+		output.SetCardinality(0);
+		return;
+	}
+	output.Reference(*local_state.chunk);
+}
+
+struct TrancoRankHistoryData : public TableFunctionData {
+	Value domain;
+};
+
+struct TrancoDiffData : public TableFunctionData {
+	Value date_a;
+	Value date_b;
+};
+} // namespace
+
+unique_ptr<FunctionData> TrancoRankHistoryFunc::Bind(ClientContext &, TableFunctionBindInput &input,
+                                                     vector<LogicalType> &return_types, vector<string> &names) {
+	// 0. list_date: date of a recorded list
+	return_types.emplace_back(LogicalTypeId::DATE);
+	names.emplace_back("list_date");
+	// 1. rank: rank of the domain on that list, NULL if it was not listed
+	return_types.emplace_back(LogicalTypeId::INTEGER);
+	names.emplace_back("rank");
+
+	auto bind_data = make_uniq<TrancoRankHistoryData>();
+	bind_data->domain = input.inputs[0];
+	return std::move(bind_data);
+}
+
+unique_ptr<LocalTableFunctionState> TrancoRankHistoryFunc::InitLocal(ExecutionContext &context,
+                                                                     TableFunctionInitInput &input,
+                                                                     GlobalTableFunctionState *) {
+	auto &bind_data = input.bind_data->Cast<TrancoRankHistoryData>();
+	// Only the changes of one domain are read, the ranks in between are carried forward
+	return RunHistoryQuery(context.client,
+	                       "SELECT dates.list_date,"
+	                       " NULLIF(last_value(changes.rank IGNORE NULLS) OVER (ORDER BY dates.list_date), 0)::INTEGER"
+	                       " FROM tranco_history_dates dates"
+	                       " LEFT JOIN (SELECT list_date, rank FROM tranco_history"
+	                       " WHERE domain = lower($1::VARCHAR)) changes USING (list_date)"
+	                       " ORDER BY dates.list_date",
+	                       {bind_data.domain});
+}
+
+unique_ptr<GlobalTableFunctionState> TrancoRankHistoryFunc::InitGlobal(ClientContext &, TableFunctionInitInput &) {
+	return nullptr;
+}
+
+void TrancoRankHistoryFunc::Scan(ClientContext &, TableFunctionInput &data_p, DataChunk &output) {
+	ScanHistoryQuery(data_p, output);
+}
+
+unique_ptr<FunctionData> TrancoDiffFunc::Bind(ClientContext &, TableFunctionBindInput &input,
+                                              vector<LogicalType> &return_types, vector<string> &names) {
+	// 0. domain: domain whose rank differs between the two lists
+	return_types.emplace_back(LogicalTypeId::VARCHAR);
+	names.emplace_back("domain");
+	// 1. rank_a: rank on the list of the first date, NULL if it was not listed
+	return_types.emplace_back(LogicalTypeId::INTEGER);
+	names.emplace_back("rank_a");
+	// 2. rank_b: rank on the list of the second date, NULL if it was not listed
+	return_types.emplace_back(LogicalTypeId::INTEGER);
+	names.emplace_back("rank_b");
+
+	auto bind_data = make_uniq<TrancoDiffData>();
+	bind_data->date_a = input.inputs[0];
+	bind_data->date_b = input.inputs[1];
+	return std::move(bind_data);
+}
+
+unique_ptr<LocalTableFunctionState> TrancoDiffFunc::InitLocal(ExecutionContext &context, TableFunctionInitInput &input,
+                                                              GlobalTableFunctionState *) {
+	auto &bind_data = input.bind_data->Cast<TrancoDiffData>();
+	// Only domains with a change between the two dates can differ, the others are never aggregated
+	return RunHistoryQuery(context.client,
+	                       "SELECT domain, NULLIF(rank_a, 0)::INTEGER, NULLIF(rank_b, 0)::INTEGER FROM ("
+	                       " SELECT domain,"
+	                       " arg_max(rank, list_date) FILTER (WHERE list_date <= $1::DATE) AS rank_a,"
+	                       " arg_max(rank, list_date) FILTER (WHERE list_date <= $2::DATE) AS rank_b"
+	                       " FROM tranco_history"
+	                       " WHERE list_date <= greatest($1::DATE, $2::DATE)"
+	                       " AND domain IN (SELECT domain FROM tranco_history"
+	                       " WHERE list_date > least($1::DATE, $2::DATE) AND list_date <= greatest($1::DATE, $2::DATE))"
+	                       " GROUP BY domain)"
+	                       " WHERE coalesce(rank_a, 0) <> coalesce(rank_b, 0)"
+	                       " ORDER BY coalesce(NULLIF(rank_b, 0), NULLIF(rank_a, 0)), domain",
+	                       {bind_data.date_a, bind_data.date_b});
+}
+
+unique_ptr<GlobalTableFunctionState> TrancoDiffFunc::InitGlobal(ClientContext &, TableFunctionInitInput &) {
+	return nullptr;
+}
+
+void TrancoDiffFunc::Scan(ClientContext &, TableFunctionInput &data_p, DataChunk &output) {
+	ScanHistoryQuery(data_p, output);
+}
+} // namespace duckdb::netquack
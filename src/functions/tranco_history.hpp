@@ -0,0 +1,31 @@
+// Copyright 2026 Arash Hatami
+
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb::netquack {
+// Add the list in `tranco_list` to the history as the list of `date` ("YYYY-MM-DD"), through the open transaction
+// of `con`. Only the domains whose rank changed since the previous list are stored, with rank 0 for dropped ones.
+void RecordTrancoHistory(Connection &con, const std::string &date);
+
+// Table function returning the rank of one domain on every list in the history
+struct TrancoRankHistoryFunc {
+	static unique_ptr<FunctionData> Bind(ClientContext &context, TableFunctionBindInput &input,
+	                                     vector<LogicalType> &return_types, vector<string> &names);
+	static void Scan(ClientContext &context, TableFunctionInput &data_p, DataChunk &output);
+	static unique_ptr<LocalTableFunctionState> InitLocal(ExecutionContext &context, TableFunctionInitInput &input,
+	                                                     GlobalTableFunctionState *global_state_p);
+	static unique_ptr<GlobalTableFunctionState> InitGlobal(ClientContext &context, TableFunctionInitInput &input);
+};
+
+// Table function returning the domains whose rank differs between the lists of two dates
+struct TrancoDiffFunc {
+	static unique_ptr<FunctionData> Bind(ClientContext &context, TableFunctionBindInput &input,
+	                                     vector<LogicalType> &return_types, vector<string> &names);
+	static void Scan(ClientContext &context, TableFunctionInput &data_p, DataChunk &output);
+	static unique_ptr<LocalTableFunctionState> InitLocal(ExecutionContext &context, TableFunctionInitInput &input,
+	                                                     GlobalTableFunctionState *global_state_p);
+	static unique_ptr<GlobalTableFunctionState> InitGlobal(ClientContext &context, TableFunctionInitInput &input);
+};
+} // namespace duckdb::netquack
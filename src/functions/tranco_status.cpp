@@ -0,0 +1,65 @@
+// Copyright 2026 Arash Hatami
+
+#include "tranco_status.hpp"
+
+#include "../utils/tranco_index.hpp"
+#include "get_tranco.hpp"
+
+namespace duckdb::netquack {
+struct TrancoStatusLocalState : public LocalTableFunctionState {
+	std::atomic_bool done {false};
+};
+
+unique_ptr<FunctionData> TrancoStatusFunc::Bind(ClientContext &, TableFunctionBindInput &,
+                                                vector<LogicalType> &return_types, vector<string> &names) {
+	// 0. list_date: date of the active list, NULL if there is none or it was loaded from a table of unknown origin
+	return_types.emplace_back(LogicalTypeId::DATE);
+	names.emplace_back("list_date");
+	// 1. domains: domains in the active list, NULL if there is none
+	return_types.emplace_back(LogicalTypeId::UBIGINT);
+	names.emplace_back("domains");
+	// 2. mapped: whether the active list is served from a mapped snapshot
+	return_types.emplace_back(LogicalTypeId::BOOLEAN);
+	names.emplace_back("mapped");
+	// 3. refreshing: whether a background refresh is in progress
+	return_types.emplace_back(LogicalTypeId::BOOLEAN);
+	names.emplace_back("refreshing");
+	// 4. last_error: error of the last refresh, NULL if it succeeded
+	return_types.emplace_back(LogicalTypeId::VARCHAR);
+	names.emplace_back("last_error");
+	// 5. catalogs: attached catalogs, of any database of the process, that share the index, 0 if it is read per query
+	return_types.emplace_back(LogicalTypeId::UBIGINT);
+	names.emplace_back("catalogs");
+	return make_uniq<TableFunctionData>();
+}
+
+unique_ptr<LocalTableFunctionState> TrancoStatusFunc::InitLocal(ExecutionContext &, TableFunctionInitInput &,
+                                                                GlobalTableFunctionState *) {
+	return make_uniq<TrancoStatusLocalState>();
+}
+
+unique_ptr<GlobalTableFunctionState> TrancoStatusFunc::InitGlobal(ClientContext &, TableFunctionInitInput &) {
+	return nullptr;
+}
+
+void TrancoStatusFunc::Scan(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &local_state = dynamic_cast<TrancoStatusLocalState &>(*data_p.local_state);
+	if (local_state.done) {
+		return;
+	}
+
+	// The index the next lookup would use
+	auto index = TrancoIndex::forTable(context);
+	auto refresh = GetTrancoRefreshStatus(*context.db);
+
+	output.SetCardinality(1);
+	output.data[0].SetValue(0, index && !index->date().empty() ? Value::DATE(Date::FromString(index->date()))
+	                                                           : Value(LogicalType::DATE));
+	output.data[1].SetValue(0, index ? Value::UBIGINT(index->size()) : Value(LogicalType::UBIGINT));
+	output.data[2].SetValue(0, Value::BOOLEAN(index && index->mapped()));
+	output.data[3].SetValue(0, Value::BOOLEAN(refresh.running));
+	output.data[4].SetValue(0, refresh.last_error.empty() ? Value(LogicalType::VARCHAR) : Value(refresh.last_error));
+	output.data[5].SetValue(0, Value::UBIGINT(index ? TrancoIndex::sharedBy(*index) : 0));
+	local_state.done = true;
+}
+} // namespace duckdb::netquack
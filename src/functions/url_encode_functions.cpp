@@ -4,6 +4,8 @@
 
 #include <array>
 
+#include "../utils/vector_helpers.hpp"
+
 namespace duckdb {
 
 // RFC 3986 unreserved characters: A-Z a-z 0-9 - _ . ~
@@ -52,39 +54,23 @@ static int HexVal(char c) {
 }
 
 void UrlEncodeFunction(DataChunk &args, ExpressionState &, Vector &result) {
-	const auto &input_vector = args.data[0];
-	auto result_data = FlatVector::GetData<string_t>(result);
-	auto &result_validity = FlatVector::Validity(result);
-
-	for (idx_t i = 0; i < args.size(); i++) {
-		auto value = input_vector.GetValue(i);
-		if (value.IsNull()) {
-			result_validity.SetInvalid(i);
-			continue;
-		}
+	auto &input_vector = args.data[0];
 
-		auto input = value.ToString();
+	netquack::ExecuteUnary<string_t, string_t>(input_vector, result, args.size(), [&](string_t value, Vector &target) {
+		auto input = value.GetString();
 		auto encoded = netquack::UrlEncode(input);
-		result_data[i] = StringVector::AddString(result, encoded);
-	}
+		return StringVector::AddString(target, encoded);
+	});
 }
 
 void UrlDecodeFunction(DataChunk &args, ExpressionState &, Vector &result) {
-	const auto &input_vector = args.data[0];
-	auto result_data = FlatVector::GetData<string_t>(result);
-	auto &result_validity = FlatVector::Validity(result);
-
-	for (idx_t i = 0; i < args.size(); i++) {
-		auto value = input_vector.GetValue(i);
-		if (value.IsNull()) {
-			result_validity.SetInvalid(i);
-			continue;
-		}
+	auto &input_vector = args.data[0];
 
-		auto input = value.ToString();
+	netquack::ExecuteUnary<string_t, string_t>(input_vector, result, args.size(), [&](string_t value, Vector &target) {
+		auto input = value.GetString();
 		auto decoded = netquack::UrlDecode(input);
-		result_data[i] = StringVector::AddString(result, decoded);
-	}
+		return StringVector::AddString(target, decoded);
+	});
 }
 
 namespace netquack {
@@ -5,41 +5,26 @@
 #include <string>
 
 #include "../utils/url_helpers.hpp"
+#include "../utils/vector_helpers.hpp"
 
 namespace duckdb {
 
 void IsValidURLFunction(DataChunk &args, ExpressionState &, Vector &result) {
-	const auto &input_vector = args.data[0];
-	auto result_data = FlatVector::GetData<bool>(result);
-	auto &result_validity = FlatVector::Validity(result);
-
-	for (idx_t i = 0; i < args.size(); i++) {
-		auto value = input_vector.GetValue(i);
-		if (value.IsNull()) {
-			result_validity.SetInvalid(i);
-			continue;
-		}
+	auto &input_vector = args.data[0];
 
-		auto input = value.ToString();
-		result_data[i] = netquack::IsValidURL(input);
-	}
+	netquack::ExecuteUnary<string_t, bool>(input_vector, result, args.size(), [&](string_t value, Vector &) {
+		auto input = value.GetString();
+		return netquack::IsValidURL(input);
+	});
 }
 
 void IsValidDomainFunction(DataChunk &args, ExpressionState &, Vector &result) {
-	const auto &input_vector = args.data[0];
-	auto result_data = FlatVector::GetData<bool>(result);
-	auto &result_validity = FlatVector::Validity(result);
-
-	for (idx_t i = 0; i < args.size(); i++) {
-		auto value = input_vector.GetValue(i);
-		if (value.IsNull()) {
-			result_validity.SetInvalid(i);
-			continue;
-		}
+	auto &input_vector = args.data[0];
 
-		auto input = value.ToString();
-		result_data[i] = netquack::IsValidDomain(input);
-	}
+	netquack::ExecuteUnary<string_t, bool>(input_vector, result, args.size(), [&](string_t value, Vector &) {
+		auto input = value.GetString();
+		return netquack::IsValidDomain(input);
+	});
 }
 
 namespace netquack {
@@ -5,8 +5,10 @@
 #include "netquack_extension.hpp"
 
 #include "duckdb/common/exception.hpp"
+#include "duckdb/main/config.hpp"
 #include "duckdb/function/scalar_function.hpp"
 #include "functions/base64_functions.hpp"
+#include "functions/domain_cache_stats.hpp"
 #include "functions/extract_domain.hpp"
 #include "functions/domain_depth.hpp"
 #include "functions/extract_extension.hpp"
@@ -20,20 +22,55 @@
 #include "functions/extract_schema.hpp"
 #include "functions/extract_subdomain.hpp"
 #include "functions/extract_tld.hpp"
+#include "functions/geoip_lookup.hpp"
 #include "functions/get_tranco.hpp"
 #include "functions/get_version.hpp"
 #include "functions/ip_functions.hpp"
+#include "functions/ip_index.hpp"
+#include "functions/ip_in_range.hpp"
+#include "functions/ip_type.hpp"
 #include "functions/ipcalc.hpp"
+#include "functions/load_public_suffix_list.hpp"
 #include "functions/normalize_url.hpp"
+#include "functions/parse_failure_stats.hpp"
+#include "functions/parse_uri.hpp"
+#include "functions/tranco_history.hpp"
+#include "functions/tranco_status.hpp"
 #include "functions/validation_functions.hpp"
+#include "utils/domain_cache.hpp"
+#include "utils/tranco_index.hpp"
 
 namespace duckdb {
 // Load the extension into the database
 static void LoadInternal(ExtensionLoader &loader) {
 	loader.SetDescription("Parsing, extracting, and analyzing domains, URIs, and paths with ease.");
 
+	auto &config = DBConfig::GetConfig(loader.GetDatabaseInstance());
+	config.AddExtensionOption("netquack_domain_cache_size",
+	                          "Entries of the per-thread host -> domain cache of the domain functions (0 disables it)",
+	                          LogicalType::UBIGINT, Value::UBIGINT(netquack::DomainCache::DEFAULT_CAPACITY));
+	config.AddExtensionOption("netquack_null_on_error",
+	                          "Return NULL instead of a fallback value when a function cannot parse its input",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("netquack_tranco_legacy_types",
+	                          "Return Tranco ranks and categories as VARCHAR like earlier versions",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("netquack_tranco_streaming",
+	                          "Parse the Tranco list while it downloads instead of saving it as a CSV file first",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("netquack_tranco_list_url",
+	                          "Download the Tranco list from this URL instead of tranco-list.eu, empty for the default",
+	                          LogicalType::VARCHAR, Value(""));
+	config.AddExtensionOption("netquack_tranco_list_date",
+	                          "Load the Tranco list of this day (YYYY-MM-DD), empty for yesterday's list",
+	                          LogicalType::VARCHAR, Value(""));
+	config.AddExtensionOption("netquack_tranco_history",
+	                          "Record the rank changes of every loaded Tranco list for the history functions",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+
 	auto netquack_extract_domain_function =
 	    ScalarFunction("extract_domain", {LogicalType::VARCHAR}, LogicalType::VARCHAR, ExtractDomainFunction);
+	netquack_extract_domain_function.init_local_state = netquack::DomainCacheLocalState::Init;
 	loader.RegisterFunction(netquack_extract_domain_function);
 
 	auto netquack_extract_path_function =
@@ -52,6 +89,10 @@ static void LoadInternal(ExtensionLoader &loader) {
 	                                                             LogicalType::VARCHAR, ExtractQueryStringFunction);
 	loader.RegisterFunction(netquack_extract_query_string_function);
 
+	auto parse_uri_function =
+	    ScalarFunction("parse_uri", {LogicalType::VARCHAR}, netquack::ParseURIType(), ParseURIFunction);
+	loader.RegisterFunction(parse_uri_function);
+
 	auto extract_query_parameters_function = TableFunction("extract_query_parameters", {LogicalType::VARCHAR}, nullptr,
 	                                                       netquack::ExtractQueryParametersFunc::Bind, nullptr,
 	                                                       netquack::ExtractQueryParametersFunc::InitLocal);
@@ -60,12 +101,24 @@ static void LoadInternal(ExtensionLoader &loader) {
 
 	auto netquack_extract_tld_function =
 	    ScalarFunction("extract_tld", {LogicalType::VARCHAR}, LogicalType::VARCHAR, ExtractTLDFunction);
+	netquack_extract_tld_function.init_local_state = netquack::DomainCacheLocalState::Init;
 	loader.RegisterFunction(netquack_extract_tld_function);
 
 	auto netquack_extract_subdomain_function =
 	    ScalarFunction("extract_subdomain", {LogicalType::VARCHAR}, LogicalType::VARCHAR, ExtractSubDomainFunction);
+	netquack_extract_subdomain_function.init_local_state = netquack::DomainCacheLocalState::Init;
 	loader.RegisterFunction(netquack_extract_subdomain_function);
 
+	auto load_public_suffix_list_function = ScalarFunction("load_public_suffix_list", {LogicalType::VARCHAR},
+	                                                       LogicalType::VARCHAR, LoadPublicSuffixListFunction);
+	load_public_suffix_list_function.SetVolatile();
+	loader.RegisterFunction(load_public_suffix_list_function);
+
+	auto reset_public_suffix_list_function =
+	    ScalarFunction("load_public_suffix_list", {}, LogicalType::VARCHAR, ResetPublicSuffixListFunction);
+	reset_public_suffix_list_function.SetVolatile();
+	loader.RegisterFunction(reset_public_suffix_list_function);
+
 	auto netquack_extract_port_function =
 	    ScalarFunction("extract_port", {LogicalType::VARCHAR}, LogicalType::VARCHAR, ExtractPortFunction);
 	loader.RegisterFunction(netquack_extract_port_function);
@@ -74,43 +127,112 @@ static void LoadInternal(ExtensionLoader &loader) {
 	    ScalarFunction("extract_extension", {LogicalType::VARCHAR}, LogicalType::VARCHAR, ExtractExtensionFunction);
 	loader.RegisterFunction(netquack_extract_extension_function);
 
-	auto netquack_update_tranco_function = ScalarFunction("update_tranco", {LogicalType::BOOLEAN}, LogicalType::VARCHAR,
-	                                                      netquack::UpdateTrancoListFunction);
-	loader.RegisterFunction(netquack_update_tranco_function);
-
-	auto get_tranco_rank_function = ScalarFunction("get_tranco_rank", {LogicalType::VARCHAR}, LogicalType::VARCHAR,
-	                                               netquack::GetTrancoRankFunction);
-	loader.RegisterFunction(get_tranco_rank_function);
-
-	auto get_tranco_rank_category_function =
-	    ScalarFunction("get_tranco_rank_category", {LogicalType::VARCHAR}, LogicalType::VARCHAR,
-	                   netquack::GetTrancoRankCategoryFunction);
-	loader.RegisterFunction(get_tranco_rank_category_function);
+	// update_tranco(force) refreshes synchronously, update_tranco(force, true) in the background.
+	// update_tranco(path) imports a local file instead of downloading the list.
+	ScalarFunctionSet netquack_update_tranco_functions("update_tranco");
+	for (auto &source_type : {LogicalType::BOOLEAN, LogicalType::VARCHAR}) {
+		netquack_update_tranco_functions.AddFunction(
+		    ScalarFunction({source_type}, LogicalType::VARCHAR, netquack::UpdateTrancoListFunction));
+		netquack_update_tranco_functions.AddFunction(ScalarFunction(
+		    {source_type, LogicalType::BOOLEAN}, LogicalType::VARCHAR, netquack::UpdateTrancoListFunction));
+	}
+	loader.RegisterFunction(netquack_update_tranco_functions);
+
+	// The optional second argument names the fallback for unlisted hosts, see BindTrancoRankFunction
+	ScalarFunctionSet get_tranco_rank_functions("get_tranco_rank");
+	ScalarFunctionSet get_tranco_rank_category_functions("get_tranco_rank_category");
+	for (idx_t argument_count = 1; argument_count <= 2; ++argument_count) {
+		vector<LogicalType> arguments(argument_count, LogicalType::VARCHAR);
+		auto get_tranco_rank_function = ScalarFunction(arguments, LogicalType::INTEGER, netquack::GetTrancoRankFunction,
+		                                               netquack::BindTrancoRankFunction);
+		get_tranco_rank_function.init_local_state = netquack::TrancoIndexLocalState::Init;
+		get_tranco_rank_functions.AddFunction(get_tranco_rank_function);
+
+		auto get_tranco_rank_category_function =
+		    ScalarFunction(arguments, netquack::TrancoCategoryType(), netquack::GetTrancoRankCategoryFunction,
+		                   netquack::BindTrancoRankFunction);
+		get_tranco_rank_category_function.init_local_state = netquack::TrancoIndexLocalState::Init;
+		get_tranco_rank_category_functions.AddFunction(get_tranco_rank_category_function);
+	}
+	loader.RegisterFunction(get_tranco_rank_functions);
+	loader.RegisterFunction(get_tranco_rank_category_functions);
+
+	auto in_tranco_top_function = ScalarFunction("in_tranco_top", {LogicalType::VARCHAR, LogicalType::INTEGER},
+	                                             LogicalType::BOOLEAN, netquack::InTrancoTopFunction);
+	in_tranco_top_function.init_local_state = netquack::TrancoIndexLocalState::Init;
+	loader.RegisterFunction(in_tranco_top_function);
 
 	auto ipcalc_function = TableFunction("ipcalc", {LogicalType::VARCHAR}, nullptr, netquack::IPCalcFunc::Bind, nullptr,
 	                                     netquack::IPCalcFunc::InitLocal);
 	ipcalc_function.in_out_function = netquack::IPCalcFunc::Function;
 	loader.RegisterFunction(ipcalc_function);
 
-	auto is_valid_ip_function =
-	    ScalarFunction("is_valid_ip", {LogicalType::VARCHAR}, LogicalType::BOOLEAN, IsValidIPFunction);
-	loader.RegisterFunction(is_valid_ip_function);
-
-	auto is_private_ip_function =
-	    ScalarFunction("is_private_ip", {LogicalType::VARCHAR}, LogicalType::BOOLEAN, IsPrivateIPFunction);
-	loader.RegisterFunction(is_private_ip_function);
-
-	auto ip_to_int_function =
-	    ScalarFunction("ip_to_int", {LogicalType::VARCHAR}, LogicalType::UBIGINT, IPToIntFunction);
-	loader.RegisterFunction(ip_to_int_function);
+	auto ip_type = netquack::IPType();
+	loader.RegisterType("IP", ip_type);
+	loader.RegisterCastFunction(LogicalType::VARCHAR, ip_type, BoundCastInfo(netquack::CastVarcharToIP));
+	loader.RegisterCastFunction(ip_type, LogicalType::VARCHAR, BoundCastInfo(netquack::CastIPToVarchar));
+
+	ScalarFunctionSet is_valid_ip_functions("is_valid_ip");
+	is_valid_ip_functions.AddFunction(ScalarFunction({LogicalType::VARCHAR}, LogicalType::BOOLEAN, IsValidIPFunction));
+	is_valid_ip_functions.AddFunction(
+	    ScalarFunction({ip_type}, LogicalType::BOOLEAN, netquack::IsValidIPAddressFunction));
+	loader.RegisterFunction(is_valid_ip_functions);
+
+	ScalarFunctionSet is_private_ip_functions("is_private_ip");
+	is_private_ip_functions.AddFunction(
+	    ScalarFunction({LogicalType::VARCHAR}, LogicalType::BOOLEAN, IsPrivateIPFunction));
+	is_private_ip_functions.AddFunction(
+	    ScalarFunction({ip_type}, LogicalType::BOOLEAN, netquack::IsPrivateIPAddressFunction));
+	loader.RegisterFunction(is_private_ip_functions);
+
+	ScalarFunctionSet ip_to_int_functions("ip_to_int");
+	ip_to_int_functions.AddFunction(ScalarFunction({LogicalType::VARCHAR}, LogicalType::UBIGINT, IPToIntFunction));
+	ip_to_int_functions.AddFunction(ScalarFunction({ip_type}, LogicalType::UBIGINT, netquack::IPAddressToIntFunction));
+	loader.RegisterFunction(ip_to_int_functions);
+
+	ScalarFunctionSet ip_in_range_functions("ip_in_range");
+	ip_in_range_functions.AddFunction(ScalarFunction({LogicalType::VARCHAR, LogicalType::VARCHAR}, LogicalType::BOOLEAN,
+	                                                 netquack::IPInRangeFunction, netquack::BindIPInRangeFunction));
+	ip_in_range_functions.AddFunction(ScalarFunction({ip_type, LogicalType::VARCHAR}, LogicalType::BOOLEAN,
+	                                                 netquack::IPAddressInRangeFunction,
+	                                                 netquack::BindIPInRangeFunction));
+	loader.RegisterFunction(ip_in_range_functions);
+
+	auto create_ip_index_function = ScalarFunction(
+	    "create_ip_index", {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR},
+	    LogicalType::UBIGINT, netquack::CreateIPIndexFunction);
+	create_ip_index_function.SetVolatile();
+	loader.RegisterFunction(create_ip_index_function);
+
+	ScalarFunctionSet ip_lookup_functions("ip_lookup");
+	auto ip_lookup_function = ScalarFunction({LogicalType::VARCHAR, LogicalType::VARCHAR}, LogicalType::VARCHAR,
+	                                         netquack::IPLookupFunction, netquack::BindIPLookupFunction);
+	ip_lookup_function.init_local_state = netquack::IPIndexLocalState::Init;
+	ip_lookup_functions.AddFunction(ip_lookup_function);
+	auto ip_address_lookup_function = ScalarFunction({LogicalType::VARCHAR, ip_type}, LogicalType::VARCHAR,
+	                                                 netquack::IPAddressLookupFunction, netquack::BindIPLookupFunction);
+	ip_address_lookup_function.init_local_state = netquack::IPIndexLocalState::Init;
+	ip_lookup_functions.AddFunction(ip_address_lookup_function);
+	loader.RegisterFunction(ip_lookup_functions);
+
+	ScalarFunctionSet geoip_lookup_functions("geoip_lookup");
+	geoip_lookup_functions.AddFunction(ScalarFunction({LogicalType::VARCHAR, LogicalType::VARCHAR},
+	                                                  netquack::GeoIPLookupType(), netquack::GeoIPLookupFunction,
+	                                                  netquack::BindGeoIPLookupFunction));
+	geoip_lookup_functions.AddFunction(ScalarFunction({ip_type, LogicalType::VARCHAR}, netquack::GeoIPLookupType(),
+	                                                  netquack::GeoIPAddressLookupFunction,
+	                                                  netquack::BindGeoIPLookupFunction));
+	loader.RegisterFunction(geoip_lookup_functions);
 
 	auto int_to_ip_function =
 	    ScalarFunction("int_to_ip", {LogicalType::UBIGINT}, LogicalType::VARCHAR, IntToIPFunction);
 	loader.RegisterFunction(int_to_ip_function);
 
-	auto ip_version_function =
-	    ScalarFunction("ip_version", {LogicalType::VARCHAR}, LogicalType::TINYINT, IPVersionFunction);
-	loader.RegisterFunction(ip_version_function);
+	ScalarFunctionSet ip_version_functions("ip_version");
+	ip_version_functions.AddFunction(ScalarFunction({LogicalType::VARCHAR}, LogicalType::TINYINT, IPVersionFunction));
+	ip_version_functions.AddFunction(
+	    ScalarFunction({ip_type}, LogicalType::TINYINT, netquack::IPAddressVersionFunction));
+	loader.RegisterFunction(ip_version_functions);
 
 	auto netquack_extract_fragment_function =
 	    ScalarFunction("extract_fragment", {LogicalType::VARCHAR}, LogicalType::VARCHAR, ExtractFragmentFunction);
@@ -154,6 +276,33 @@ static void LoadInternal(ExtensionLoader &loader) {
 	    ScalarFunction("url_decode", {LogicalType::VARCHAR}, LogicalType::VARCHAR, UrlDecodeFunction);
 	loader.RegisterFunction(url_decode_function);
 
+	auto domain_cache_stats_function = TableFunction(
+	    "domain_cache_stats", {}, netquack::DomainCacheStatsFunc::Scan, netquack::DomainCacheStatsFunc::Bind,
+	    netquack::DomainCacheStatsFunc::InitGlobal, netquack::DomainCacheStatsFunc::InitLocal);
+	loader.RegisterFunction(domain_cache_stats_function);
+
+	auto parse_failure_stats_function = TableFunction(
+	    "parse_failure_stats", {}, netquack::ParseFailureStatsFunc::Scan, netquack::ParseFailureStatsFunc::Bind,
+	    netquack::ParseFailureStatsFunc::InitGlobal, netquack::ParseFailureStatsFunc::InitLocal);
+	loader.RegisterFunction(parse_failure_stats_function);
+
+	auto tranco_status_function =
+	    TableFunction("tranco_status", {}, netquack::TrancoStatusFunc::Scan, netquack::TrancoStatusFunc::Bind,
+	                  netquack::TrancoStatusFunc::InitGlobal, netquack::TrancoStatusFunc::InitLocal);
+	loader.RegisterFunction(tranco_status_function);
+
+	auto tranco_rank_history_function = TableFunction(
+	    "tranco_rank_history", {LogicalType::VARCHAR}, netquack::TrancoRankHistoryFunc::Scan,
+	    netquack::TrancoRankHistoryFunc::Bind, netquack::TrancoRankHistoryFunc::InitGlobal,
+	    netquack::TrancoRankHistoryFunc::InitLocal);
+	loader.RegisterFunction(tranco_rank_history_function);
+
+	auto tranco_diff_function =
+	    TableFunction("tranco_diff", {LogicalType::DATE, LogicalType::DATE}, netquack::TrancoDiffFunc::Scan,
+	                  netquack::TrancoDiffFunc::Bind, netquack::TrancoDiffFunc::InitGlobal,
+	                  netquack::TrancoDiffFunc::InitLocal);
+	loader.RegisterFunction(tranco_diff_function);
+
 	auto version_function =
 	    TableFunction("netquack_version", {}, netquack::VersionFunc::Scan, netquack::VersionFunc::Bind,
 	                  netquack::VersionFunc::InitGlobal, netquack::VersionFunc::InitLocal);
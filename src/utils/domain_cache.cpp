@@ -0,0 +1,110 @@
+// Copyright 2026 Arash Hatami
+
+#include "domain_cache.hpp"
+
+#include <atomic>
+#include <cstring>
+
+namespace duckdb::netquack {
+namespace {
+std::atomic<uint64_t> total_hits {0};
+std::atomic<uint64_t> total_misses {0};
+
+// FNV-1a, hosts are short enough that a byte loop is fine
+uint64_t hashHost(std::string_view host) {
+	uint64_t hash = 14695981039346656037ULL;
+	for (char c : host) {
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+} // namespace
+
+DomainCache::DomainCache(size_t capacity) : capacity(capacity) {
+	size_t set_count = 1;
+	while (set_count * 2 < capacity) {
+		set_count *= 2;
+	}
+	set_mask = set_count - 1;
+}
+
+DomainCache::~DomainCache() {
+	total_hits += hit_count;
+	total_misses += miss_count;
+}
+
+void DomainCache::setList(const PublicSuffixList &list) {
+	suffix_list = &list;
+	if (list.id() != list_id) {
+		list_id = list.id();
+		entries.clear();
+		recent_way.clear();
+	}
+}
+
+DomainParts DomainCache::splitDomain(std::string_view host) {
+	if (capacity == 0 || host.empty() || host.size() > MAX_HOST_LENGTH) {
+		return netquack::splitDomain(host, *suffix_list);
+	}
+	if (entries.empty()) {
+		entries.resize((set_mask + 1) * 2);
+		recent_way.resize(set_mask + 1);
+	}
+
+	uint64_t hash = hashHost(host);
+	size_t set = hash & set_mask;
+	Entry *ways = &entries[set * 2];
+	for (uint8_t way = 0; way < 2; ++way) {
+		auto &entry = ways[way];
+		if (entry.hash == hash && entry.host_length == host.size() &&
+		    memcmp(entry.host, host.data(), host.size()) == 0) {
+			++hit_count;
+			recent_way[set] = way;
+			DomainParts parts;
+			parts.subdomain = host.substr(0, entry.subdomain_length);
+			parts.domain = host.substr(entry.domain_start);
+			parts.tld = host.substr(entry.tld_start);
+			return parts;
+		}
+	}
+
+	++miss_count;
+	auto parts = netquack::splitDomain(host, *suffix_list);
+
+	// Replace the way that was not used last
+	uint8_t way = recent_way[set] ^ 1;
+	auto &entry = ways[way];
+	entry.hash = hash;
+	entry.host_length = static_cast<uint8_t>(host.size());
+	entry.subdomain_length = static_cast<uint8_t>(parts.subdomain.size());
+	entry.domain_start = static_cast<uint8_t>(host.size() - parts.domain.size());
+	entry.tld_start = static_cast<uint8_t>(host.size() - parts.tld.size());
+	memcpy(entry.host, host.data(), host.size());
+	recent_way[set] = way;
+	return parts;
+}
+
+DomainCache::Statistics DomainCache::statistics() {
+	return {total_hits.load(), total_misses.load()};
+}
+
+size_t DomainCache::configuredCapacity(ClientContext &context) {
+	Value cache_size;
+	if (context.TryGetCurrentSetting("netquack_domain_cache_size", cache_size) && !cache_size.IsNull()) {
+		return cache_size.GetValue<uint64_t>();
+	}
+	return DEFAULT_CAPACITY;
+}
+
+unique_ptr<FunctionLocalState> DomainCacheLocalState::Init(ExpressionState &state, const BoundFunctionExpression &,
+                                                           FunctionData *) {
+	return make_uniq<DomainCacheLocalState>(DomainCache::configuredCapacity(state.GetContext()));
+}
+
+DomainCache &DomainCacheLocalState::GetCache(ExpressionState &state, const PublicSuffixList &list) {
+	auto &cache = ExecuteFunctionState::GetFunctionState(state)->Cast<DomainCacheLocalState>().cache;
+	cache.setList(list);
+	return cache;
+}
+} // namespace duckdb::netquack
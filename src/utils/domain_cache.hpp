@@ -0,0 +1,90 @@
+// Copyright 2026 Arash Hatami
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "duckdb.hpp"
+#include "tld_lookup.hpp"
+
+namespace duckdb::netquack {
+// Bounded memo of host -> registrable domain splits, meant to be owned by one thread.
+// Two-way set associative: a host maps to one set, the least recently used way of the set is replaced.
+// Entries store the split as offsets into the host, so cached results are views into the caller's host.
+class DomainCache {
+public:
+	// Hosts longer than this are split without the cache
+	static constexpr size_t MAX_HOST_LENGTH = 80;
+	// Entries per cache unless `netquack_domain_cache_size` says otherwise
+	static constexpr size_t DEFAULT_CAPACITY = 2048;
+
+	// Process-wide counters of all caches, updated when a cache is destroyed
+	struct Statistics {
+		uint64_t hits;
+		uint64_t misses;
+	};
+
+	// Cache of about `capacity` entries (rounded up to a power of two), 0 disables it
+	explicit DomainCache(size_t capacity);
+	// Capacity set by `netquack_domain_cache_size`
+	static size_t configuredCapacity(ClientContext &context);
+	~DomainCache();
+
+	// Use `list` for the following lookups, entries computed with another list are dropped
+	void setList(const PublicSuffixList &list);
+	const PublicSuffixList &list() const {
+		return *suffix_list;
+	}
+
+	// Same as splitDomain(host, list()), reusing the result for hosts seen before
+	DomainParts splitDomain(std::string_view host);
+
+	uint64_t hits() const {
+		return hit_count;
+	}
+	uint64_t misses() const {
+		return miss_count;
+	}
+
+	static Statistics statistics();
+
+private:
+	struct Entry {
+		uint64_t hash;
+		uint8_t host_length; // 0 for an empty slot
+		uint8_t subdomain_length;
+		uint8_t domain_start;
+		uint8_t tld_start;
+		char host[MAX_HOST_LENGTH];
+	};
+
+	size_t capacity;
+	size_t set_mask = 0;
+	// Ways of set `i` are entries[2 * i] and entries[2 * i + 1], allocated on first use
+	std::vector<Entry> entries;
+	// Way of each set that was used last
+	std::vector<uint8_t> recent_way;
+
+	const PublicSuffixList *suffix_list = nullptr;
+	uint64_t list_id = 0;
+
+	uint64_t hit_count = 0;
+	uint64_t miss_count = 0;
+};
+
+// Function local state of the scalar functions that split hosts with the public suffix list
+struct DomainCacheLocalState : public FunctionLocalState {
+	explicit DomainCacheLocalState(size_t capacity) : cache(capacity) {
+	}
+
+	DomainCache cache;
+
+	// Size the cache with the `netquack_domain_cache_size` setting
+	static unique_ptr<FunctionLocalState> Init(ExpressionState &state, const BoundFunctionExpression &expr,
+	                                           FunctionData *bind_data);
+	// The cache of the executing thread, switched to `list`
+	static DomainCache &GetCache(ExpressionState &state, const PublicSuffixList &list);
+};
+} // namespace duckdb::netquack
@@ -0,0 +1,285 @@
+// Copyright 2026 Arash Hatami
+
+#pragma once
+
+// Vectorized search for a compile-time set of ASCII symbols, and ASCII lower-casing.
+// x86-64 always has SSE2, AVX2 is selected at runtime on GCC/Clang builds, and AArch64 always has NEON.
+// Every other target uses the scalar loops, which also handle the tails shorter than one register.
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define NETQUACK_SIMD_SSE2 1
+#if defined(__GNUC__) || defined(__clang__)
+#define NETQUACK_SIMD_AVX2 1
+#define NETQUACK_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define NETQUACK_SIMD_NEON 1
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace duckdb::netquack::simd {
+using Pos = const char *;
+
+template <char... symbols>
+constexpr bool isAnyOf(char c) noexcept {
+	return ((c == symbols) || ...);
+}
+
+template <char... symbols>
+inline Pos findFirstScalar(Pos begin, Pos end) noexcept {
+	for (Pos pos = begin; pos < end; ++pos) {
+		if (isAnyOf<symbols...>(*pos)) {
+			return pos;
+		}
+	}
+	return end;
+}
+
+template <char... symbols>
+inline Pos findLastScalar(Pos begin, Pos end) noexcept {
+	for (Pos pos = end; pos > begin;) {
+		--pos;
+		if (isAnyOf<symbols...>(*pos)) {
+			return pos;
+		}
+	}
+	return nullptr;
+}
+
+inline uint32_t countTrailingZeros(uint32_t mask) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return index;
+#else
+	return __builtin_ctz(mask);
+#endif
+}
+
+inline uint32_t highestBit(uint32_t mask) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+	unsigned long index;
+	_BitScanReverse(&index, mask);
+	return index;
+#else
+	return 31 - __builtin_clz(mask);
+#endif
+}
+
+inline uint32_t countTrailingZeros64(uint64_t mask) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+	unsigned long index;
+	_BitScanForward64(&index, mask);
+	return index;
+#else
+	return __builtin_ctzll(mask);
+#endif
+}
+
+inline uint32_t highestBit64(uint64_t mask) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+	unsigned long index;
+	_BitScanReverse64(&index, mask);
+	return index;
+#else
+	return 63 - __builtin_clzll(mask);
+#endif
+}
+
+#ifdef NETQUACK_SIMD_SSE2
+// One bit per byte of `pos[0..16)` that matches a symbol
+template <char... symbols>
+inline uint32_t matchMask16(Pos pos) noexcept {
+	__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+	__m128i matches = _mm_setzero_si128();
+	((matches = _mm_or_si128(matches, _mm_cmpeq_epi8(bytes, _mm_set1_epi8(symbols)))), ...);
+	return static_cast<uint32_t>(_mm_movemask_epi8(matches));
+}
+
+template <char... symbols>
+inline Pos findFirstSSE2(Pos begin, Pos end) noexcept {
+	Pos pos = begin;
+	for (; end - pos >= 16; pos += 16) {
+		if (uint32_t mask = matchMask16<symbols...>(pos)) {
+			return pos + countTrailingZeros(mask);
+		}
+	}
+	return findFirstScalar<symbols...>(pos, end);
+}
+
+template <char... symbols>
+inline Pos findLastSSE2(Pos begin, Pos end) noexcept {
+	Pos pos = end;
+	for (; pos - begin >= 16; pos -= 16) {
+		if (uint32_t mask = matchMask16<symbols...>(pos - 16)) {
+			return pos - 16 + highestBit(mask);
+		}
+	}
+	return findLastScalar<symbols...>(begin, pos);
+}
+#endif
+
+#ifdef NETQUACK_SIMD_AVX2
+// One bit per byte of `pos[0..32)` that matches a symbol
+template <char... symbols>
+NETQUACK_TARGET_AVX2 inline uint32_t matchMask32(Pos pos) noexcept {
+	__m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos));
+	__m256i matches = _mm256_setzero_si256();
+	((matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(symbols)))), ...);
+	return static_cast<uint32_t>(_mm256_movemask_epi8(matches));
+}
+
+template <char... symbols>
+NETQUACK_TARGET_AVX2 Pos findFirstAVX2(Pos begin, Pos end) noexcept {
+	Pos pos = begin;
+	for (; end - pos >= 32; pos += 32) {
+		if (uint32_t mask = matchMask32<symbols...>(pos)) {
+			return pos + countTrailingZeros(mask);
+		}
+	}
+	return findFirstSSE2<symbols...>(pos, end);
+}
+
+template <char... symbols>
+NETQUACK_TARGET_AVX2 Pos findLastAVX2(Pos begin, Pos end) noexcept {
+	Pos pos = end;
+	for (; pos - begin >= 32; pos -= 32) {
+		if (uint32_t mask = matchMask32<symbols...>(pos - 32)) {
+			return pos - 32 + highestBit(mask);
+		}
+	}
+	return findLastSSE2<symbols...>(begin, pos);
+}
+
+// Checked once per process
+inline bool hasAVX2() noexcept {
+	static const bool supported = __builtin_cpu_supports("avx2");
+	return supported;
+}
+#endif
+
+#ifdef NETQUACK_SIMD_NEON
+// Four bits per byte of `pos[0..16)` that matches a symbol
+template <char... symbols>
+inline uint64_t matchMask16(Pos pos) noexcept {
+	uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t *>(pos));
+	uint8x16_t matches = vdupq_n_u8(0);
+	((matches = vorrq_u8(matches, vceqq_u8(bytes, vdupq_n_u8(static_cast<uint8_t>(symbols))))), ...);
+	uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(matches), 4);
+	return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+}
+
+template <char... symbols>
+inline Pos findFirstNEON(Pos begin, Pos end) noexcept {
+	Pos pos = begin;
+	for (; end - pos >= 16; pos += 16) {
+		if (uint64_t mask = matchMask16<symbols...>(pos)) {
+			return pos + (countTrailingZeros64(mask) >> 2);
+		}
+	}
+	return findFirstScalar<symbols...>(pos, end);
+}
+
+template <char... symbols>
+inline Pos findLastNEON(Pos begin, Pos end) noexcept {
+	Pos pos = end;
+	for (; pos - begin >= 16; pos -= 16) {
+		if (uint64_t mask = matchMask16<symbols...>(pos - 16)) {
+			return pos - 16 + (highestBit64(mask) >> 2);
+		}
+	}
+	return findLastScalar<symbols...>(begin, pos);
+}
+#endif
+
+// Copy [begin, end) to `out`, folding ASCII upper-case letters to lower case
+inline void toLowerScalar(Pos begin, Pos end, char *out) noexcept {
+	for (Pos pos = begin; pos < end; ++pos, ++out) {
+		*out = (*pos >= 'A' && *pos <= 'Z') ? static_cast<char>(*pos + ('a' - 'A')) : *pos;
+	}
+}
+
+#ifdef NETQUACK_SIMD_SSE2
+inline void toLowerSSE2(Pos begin, Pos end, char *out) noexcept {
+	// Bytes >= 0x80 are negative as signed chars, so they never fall in ['A', 'Z']
+	const __m128i before_upper = _mm_set1_epi8('A' - 1);
+	const __m128i after_upper = _mm_set1_epi8('Z' + 1);
+	const __m128i case_bit = _mm_set1_epi8(0x20);
+	Pos pos = begin;
+	for (; end - pos >= 16; pos += 16, out += 16) {
+		__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+		__m128i upper = _mm_and_si128(_mm_cmpgt_epi8(bytes, before_upper), _mm_cmplt_epi8(bytes, after_upper));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_or_si128(bytes, _mm_and_si128(upper, case_bit)));
+	}
+	toLowerScalar(pos, end, out);
+}
+#endif
+
+#ifdef NETQUACK_SIMD_NEON
+inline void toLowerNEON(Pos begin, Pos end, char *out) noexcept {
+	const uint8x16_t upper_a = vdupq_n_u8('A');
+	const uint8x16_t upper_z = vdupq_n_u8('Z');
+	const uint8x16_t case_bit = vdupq_n_u8(0x20);
+	Pos pos = begin;
+	for (; end - pos >= 16; pos += 16, out += 16) {
+		uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t *>(pos));
+		uint8x16_t upper = vandq_u8(vcgeq_u8(bytes, upper_a), vcleq_u8(bytes, upper_z));
+		vst1q_u8(reinterpret_cast<uint8_t *>(out), vorrq_u8(bytes, vandq_u8(upper, case_bit)));
+	}
+	toLowerScalar(pos, end, out);
+}
+#endif
+
+// Copy [begin, end) to `out` in ASCII lower case, `out` may equal `begin`
+inline void toLower(Pos begin, Pos end, char *out) noexcept {
+#if defined(NETQUACK_SIMD_SSE2)
+	toLowerSSE2(begin, end, out);
+#elif defined(NETQUACK_SIMD_NEON)
+	toLowerNEON(begin, end, out);
+#else
+	toLowerScalar(begin, end, out);
+#endif
+}
+
+// First position in [begin, end) holding one of `symbols`, or `end`
+template <char... symbols>
+inline Pos findFirst(Pos begin, Pos end) noexcept {
+#if defined(NETQUACK_SIMD_AVX2)
+	if (end - begin >= 32 && hasAVX2()) {
+		return findFirstAVX2<symbols...>(begin, end);
+	}
+	return findFirstSSE2<symbols...>(begin, end);
+#elif defined(NETQUACK_SIMD_SSE2)
+	return findFirstSSE2<symbols...>(begin, end);
+#elif defined(NETQUACK_SIMD_NEON)
+	return findFirstNEON<symbols...>(begin, end);
+#else
+	return findFirstScalar<symbols...>(begin, end);
+#endif
+}
+
+// Last position in [begin, end) holding one of `symbols`, or nullptr
+template <char... symbols>
+inline Pos findLast(Pos begin, Pos end) noexcept {
+#if defined(NETQUACK_SIMD_AVX2)
+	if (end - begin >= 32 && hasAVX2()) {
+		return findLastAVX2<symbols...>(begin, end);
+	}
+	return findLastSSE2<symbols...>(begin, end);
+#elif defined(NETQUACK_SIMD_SSE2)
+	return findLastSSE2<symbols...>(begin, end);
+#elif defined(NETQUACK_SIMD_NEON)
+	return findLastNEON<symbols...>(begin, end);
+#else
+	return findLastScalar<symbols...>(begin, end);
+#endif
+}
+} // namespace duckdb::netquack::simd
@@ -0,0 +1,207 @@
+// Copyright 2026 Arash Hatami
+
+#include "fuse_filter.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace duckdb::netquack {
+namespace {
+// Construction gives up after this many seeds, which only happens for keys that are not distinct
+constexpr int MAX_ATTEMPTS = 100;
+constexpr uint32_t MAX_SEGMENT_LENGTH = 262144;
+
+uint64_t murmur64(uint64_t hash) {
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+	hash *= 0xc4ceb9fe1a85ec53ULL;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+uint64_t splitmix64(uint64_t &state) {
+	uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+}
+
+// Upper half of the 128-bit product, maps `hash` onto [0, range)
+uint64_t mulhi(uint64_t hash, uint64_t range) {
+#if defined(__SIZEOF_INT128__)
+	return static_cast<uint64_t>((static_cast<__uint128_t>(hash) * range) >> 64);
+#else
+	uint64_t hash_lo = hash & 0xffffffffULL, hash_hi = hash >> 32;
+	uint64_t range_lo = range & 0xffffffffULL, range_hi = range >> 32;
+	uint64_t cross = (hash_lo * range_lo >> 32) + (hash_hi * range_lo & 0xffffffffULL) + hash_lo * range_hi;
+	return hash_hi * range_hi + (hash_hi * range_lo >> 32) + (cross >> 32);
+#endif
+}
+
+uint8_t fingerprint(uint64_t hash) {
+	return static_cast<uint8_t>(hash ^ (hash >> 32));
+}
+} // namespace
+
+size_t BinaryFuseFilter::slot(uint64_t hash, uint32_t index) const {
+	// Three consecutive segments, the offset within the second and third one is taken from the hash
+	uint64_t h = mulhi(hash, params.segment_count_length) + static_cast<uint64_t>(index) * params.segment_length;
+	uint64_t bits = hash & ((1ULL << 36) - 1);
+	h ^= (bits >> (36 - 18 * index)) & (params.segment_length - 1);
+	return static_cast<size_t>(h);
+}
+
+bool BinaryFuseFilter::contains(uint64_t key) const {
+	if (params.array_length == 0) {
+		return params.key_count != 0;
+	}
+	uint64_t hash = murmur64(key + params.seed);
+	uint8_t f = fingerprint(hash);
+	f ^= fingerprints[slot(hash, 0)] ^ fingerprints[slot(hash, 1)] ^ fingerprints[slot(hash, 2)];
+	return f == 0;
+}
+
+bool BinaryFuseFilter::view(const Layout &layout, const uint8_t *data, size_t size) {
+	// Every slot() must stay below array_length
+	if (layout.array_length != size) {
+		return false;
+	}
+	if (size != 0 && (layout.segment_length == 0 || (layout.segment_length & (layout.segment_length - 1)) != 0 ||
+	                  layout.segment_count_length % layout.segment_length != 0 ||
+	                  static_cast<uint64_t>(layout.segment_count_length) + 2ULL * layout.segment_length != size)) {
+		return false;
+	}
+	params = layout;
+	fingerprints = data;
+	storage.clear();
+	return true;
+}
+
+BinaryFuseFilter BinaryFuseFilter::build(std::vector<uint64_t> &keys) {
+	std::sort(keys.begin(), keys.end());
+	keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+	BinaryFuseFilter filter;
+	auto size = static_cast<uint32_t>(keys.size());
+	if (size == 0) {
+		return filter;
+	}
+
+	// Sizes from the reference implementation, they are tuned for construction to rarely need a second seed
+	uint32_t segment_length = 1U << static_cast<int>(std::floor(std::log(double(size)) / std::log(3.33) + 2.25));
+	segment_length = std::min(segment_length, MAX_SEGMENT_LENGTH);
+	double size_factor = size <= 1 ? 0 : std::max(1.125, 0.875 + 0.25 * std::log(1000000.0) / std::log(double(size)));
+	auto capacity = static_cast<uint32_t>(std::round(double(size) * size_factor));
+	int64_t segment_count = (int64_t(capacity) + segment_length - 1) / segment_length - 2;
+	segment_count = std::max<int64_t>(segment_count, 1);
+	auto &params = filter.params;
+	params.segment_length = segment_length;
+	params.segment_count_length = static_cast<uint32_t>(segment_count) * segment_length;
+	params.array_length = params.segment_count_length + 2 * segment_length;
+	params.key_count = size;
+	filter.storage.assign(params.array_length, 0);
+	filter.fingerprints = filter.storage.data();
+
+	auto array_length = params.array_length;
+	std::vector<uint64_t> order(size + 1);
+	std::vector<uint8_t> slot_count(array_length);
+	std::vector<uint64_t> slot_hash(array_length);
+	std::vector<uint8_t> order_index(size);
+	std::vector<uint32_t> alone(array_length);
+	uint32_t block_bits = 1;
+	while ((1U << block_bits) < static_cast<uint32_t>(segment_count)) {
+		++block_bits;
+	}
+	std::vector<uint32_t> start(1U << block_bits);
+
+	uint64_t rng = 0x726b2b9d438b9d4dULL;
+	size_t stack_size = 0;
+	for (int attempt = 0; attempt < MAX_ATTEMPTS; ++attempt) {
+		params.seed = splitmix64(rng);
+		std::fill(order.begin(), order.end(), 0);
+		order[size] = 1;
+		std::fill(slot_count.begin(), slot_count.end(), 0);
+		std::fill(slot_hash.begin(), slot_hash.end(), 0);
+
+		// Sort the hashes roughly by segment, so the counting below walks the arrays in order
+		uint32_t block_mask = (1U << block_bits) - 1;
+		for (uint32_t i = 0; i < start.size(); ++i) {
+			start[i] = static_cast<uint32_t>((uint64_t(i) * size) >> block_bits);
+		}
+		for (auto key : keys) {
+			uint64_t hash = murmur64(key + params.seed);
+			auto block = static_cast<uint32_t>(hash >> (64 - block_bits));
+			while (order[start[block]] != 0) {
+				block = (block + 1) & block_mask;
+			}
+			order[start[block]] = hash;
+			++start[block];
+		}
+
+		// Per slot: number of keys times 4 plus the xor of their positions (0 to 2), and the xor of their hashes
+		bool overflow = false;
+		for (uint32_t i = 0; i < size; ++i) {
+			uint64_t hash = order[i];
+			for (uint32_t index = 0; index < 3; ++index) {
+				auto h = filter.slot(hash, index);
+				slot_count[h] += 4;
+				slot_count[h] ^= static_cast<uint8_t>(index);
+				slot_hash[h] ^= hash;
+				overflow |= slot_count[h] < 4;
+			}
+		}
+		if (overflow) {
+			continue;
+		}
+
+		// Peel slots holding a single key until none is left
+		size_t queue_size = 0;
+		for (uint32_t i = 0; i < array_length; ++i) {
+			alone[queue_size] = i;
+			queue_size += (slot_count[i] >> 2) == 1 ? 1 : 0;
+		}
+		stack_size = 0;
+		while (queue_size > 0) {
+			uint32_t index = alone[--queue_size];
+			if ((slot_count[index] >> 2) != 1) {
+				continue;
+			}
+			uint64_t hash = slot_hash[index];
+			uint8_t found = slot_count[index] & 3;
+			order_index[stack_size] = found;
+			order[stack_size] = hash;
+			++stack_size;
+			for (uint32_t other = 1; other <= 2; ++other) {
+				uint32_t position = (found + other) % 3;
+				auto h = static_cast<uint32_t>(filter.slot(hash, position));
+				alone[queue_size] = h;
+				queue_size += (slot_count[h] >> 2) == 2 ? 1 : 0;
+				slot_count[h] -= 4;
+				slot_count[h] ^= static_cast<uint8_t>(position);
+				slot_hash[h] ^= hash;
+			}
+		}
+		if (stack_size == size) {
+			break;
+		}
+	}
+	if (stack_size != size) {
+		// Not expected for distinct keys. Without fingerprints the filter finds every key, which is still correct.
+		params = Layout {0, 0, 0, 0, size};
+		filter.storage.clear();
+		filter.fingerprints = nullptr;
+		return filter;
+	}
+
+	// Assign the fingerprints in reverse peeling order, each key owns the slot it was peeled from
+	for (size_t i = size; i-- > 0;) {
+		uint64_t hash = order[i];
+		uint8_t found = order_index[i];
+		size_t h[3] = {filter.slot(hash, 0), filter.slot(hash, 1), filter.slot(hash, 2)};
+		filter.storage[h[found]] =
+		    fingerprint(hash) ^ filter.storage[h[(found + 1) % 3]] ^ filter.storage[h[(found + 2) % 3]];
+	}
+	return filter;
+}
+} // namespace duckdb::netquack
@@ -0,0 +1,58 @@
+// Copyright 2026 Arash Hatami
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace duckdb::netquack {
+// Static set of 64-bit keys as a binary fuse filter with 8-bit fingerprints (Graf and Lemire, "Binary Fuse
+// Filters: Fast and Smaller Than Xor Filters"). About 9 bits per key. Keys that were added are always found, other
+// keys are found with a probability of 1/256. A lookup reads three bytes within a window of a few segments, which
+// usually costs one or two cache misses.
+class BinaryFuseFilter {
+public:
+	// Parameters of a filter, as stored in front of its fingerprints
+	struct Layout {
+		uint64_t seed;
+		uint32_t segment_length;
+		uint32_t segment_count_length;
+		uint32_t array_length;
+		// Keys in the filter. A filter with keys but no fingerprints finds every key.
+		uint32_t key_count;
+	};
+
+	BinaryFuseFilter() = default;
+	BinaryFuseFilter(const BinaryFuseFilter &) = delete;
+	BinaryFuseFilter &operator=(const BinaryFuseFilter &) = delete;
+	BinaryFuseFilter(BinaryFuseFilter &&) = default;
+	BinaryFuseFilter &operator=(BinaryFuseFilter &&) = default;
+
+	// Build a filter of `keys`, which are sorted and deduplicated in place
+	static BinaryFuseFilter build(std::vector<uint64_t> &keys);
+	// Filter over `fingerprints` owned by the caller, false if `layout` is not consistent with `size` bytes
+	bool view(const Layout &layout, const uint8_t *fingerprints, size_t size);
+
+	bool contains(uint64_t key) const;
+
+	const Layout &layout() const {
+		return params;
+	}
+	const uint8_t *data() const {
+		return fingerprints;
+	}
+	size_t size() const {
+		return params.array_length;
+	}
+
+private:
+	// Slot of the key's `index`-th fingerprint (0 to 2) for the mixed `hash`
+	size_t slot(uint64_t hash, uint32_t index) const;
+
+	Layout params {0, 0, 0, 0, 0};
+	// Points to either `storage` or fingerprints owned by the caller
+	const uint8_t *fingerprints = nullptr;
+	std::vector<uint8_t> storage;
+};
+} // namespace duckdb::netquack
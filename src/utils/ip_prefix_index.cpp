@@ -0,0 +1,231 @@
+// Copyright 2026 Arash Hatami
+
+#include "ip_prefix_index.hpp"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+namespace duckdb::netquack {
+namespace {
+int leadingZeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+	return value == 0 ? 64 : __builtin_clzll(value);
+#else
+	int count = 0;
+	while (count < 64 && (value & (1ULL << (63 - count))) == 0) {
+		++count;
+	}
+	return count;
+#endif
+}
+
+// Number of leading bits `a` and `b` have in common, 0 to 128
+int commonPrefixLength(uhugeint_t a, uhugeint_t b) {
+	auto upper = a.upper ^ b.upper;
+	return upper != 0 ? leadingZeros(upper) : 64 + leadingZeros(a.lower ^ b.lower);
+}
+
+// Bit `position` of `address`, counted from the most significant one
+uint32_t bitAt(uhugeint_t address, uint32_t position) {
+	return position < 64 ? (address.upper >> (63 - position)) & 1 : (address.lower >> (127 - position)) & 1;
+}
+
+uhugeint_t clearHostBits(uhugeint_t address, uint32_t length) {
+	uhugeint_t network;
+	network.upper = length >= 64 ? address.upper : length == 0 ? 0 : address.upper & (~0ULL << (64 - length));
+	network.lower = length <= 64 ? 0 : address.lower & (~0ULL << (128 - length));
+	return network;
+}
+
+// Indexes of every database, by database and lower-case name. The lock only guards swapping the pointers.
+struct NamedIndex {
+	// Tells a database apart from a later one at the same address
+	std::weak_ptr<DatabaseInstance> database;
+	std::shared_ptr<const IPPrefixIndex> index;
+};
+
+std::mutex named_indexes_lock;
+
+std::map<std::pair<const DatabaseInstance *, std::string>, NamedIndex> &namedIndexes() {
+	static std::map<std::pair<const DatabaseInstance *, std::string>, NamedIndex> indexes;
+	return indexes;
+}
+} // namespace
+
+void IPPrefixIndex::Builder::add(const IPRange &range, std::string payload) {
+	ranges.emplace_back(range, static_cast<uint32_t>(payloads.size()));
+	payloads.push_back(std::move(payload));
+}
+
+std::shared_ptr<const IPPrefixIndex> IPPrefixIndex::Builder::build() {
+	// Shorter blocks first, so longer ones overwrite them in the IPv4 tables. Duplicates keep their order.
+	std::stable_sort(ranges.begin(), ranges.end(), [](const auto &a, const auto &b) {
+		if (a.first.prefix_length != b.first.prefix_length) {
+			return a.first.prefix_length < b.first.prefix_length;
+		}
+		return a.first.network < b.first.network;
+	});
+
+	auto index = std::make_shared<IPPrefixIndex>();
+	index->nodes.push_back(Node {uhugeint_t(), {NO_NODE, NO_NODE}, 0, 0});
+	for (size_t i = 0; i < ranges.size(); ++i) {
+		auto &range = ranges[i].first;
+		if (i + 1 < ranges.size() && ranges[i + 1].first.prefix_length == range.prefix_length &&
+		    ranges[i + 1].first.network == range.network) {
+			continue;
+		}
+		index->payloads.push_back(std::move(payloads[ranges[i].second]));
+		auto entry = static_cast<uint32_t>(index->payloads.size());
+		if (range.prefix_length >= 96 && IsIPv4Address(range.network)) {
+			index->insertIPv4(static_cast<uint32_t>(range.network.lower), range.prefix_length - 96, entry);
+		} else {
+			index->insertTrie(range, entry);
+		}
+	}
+	index->block_count = index->payloads.size();
+	ranges.clear();
+	payloads.clear();
+	return index;
+}
+
+uint32_t IPPrefixIndex::addTable(uint32_t entry) {
+	auto table = static_cast<uint32_t>(tables.size() / 256);
+	tables.resize(tables.size() + 256, entry);
+	return CHILD | table;
+}
+
+void IPPrefixIndex::insertIPv4(uint32_t network, uint32_t length, uint32_t entry) {
+	if (root.empty()) {
+		root.resize(65536, 0);
+	}
+	// Blocks come in by length, so no longer block has split the entries painted here yet
+	if (length <= 16) {
+		auto first = network >> 16;
+		std::fill_n(root.begin() + first, size_t(1) << (16 - length), entry);
+		return;
+	}
+	auto &top = root[network >> 16];
+	if ((top & CHILD) == 0) {
+		top = addTable(top);
+	}
+	size_t slot = size_t(top & ~CHILD) * 256 + ((network >> 8) & 0xFF);
+	if (length <= 24) {
+		std::fill_n(tables.begin() + slot, size_t(1) << (24 - length), entry);
+		return;
+	}
+	if ((tables[slot] & CHILD) == 0) {
+		auto child = addTable(tables[slot]);
+		tables[slot] = child;
+	}
+	size_t first = size_t(tables[slot] & ~CHILD) * 256 + (network & 0xFF);
+	std::fill_n(tables.begin() + first, size_t(1) << (32 - length), entry);
+}
+
+void IPPrefixIndex::insertTrie(const IPRange &range, uint32_t entry) {
+	auto prefix = range.network;
+	uint32_t length = range.prefix_length;
+	uint32_t current = 0;
+	// The block always matches the node `current` on all of the node's bits
+	while (true) {
+		if (nodes[current].length == length) {
+			nodes[current].payload = entry;
+			return;
+		}
+		auto branch = bitAt(prefix, nodes[current].length);
+		auto child = nodes[current].children[branch];
+		if (child == NO_NODE) {
+			nodes[current].children[branch] = static_cast<uint32_t>(nodes.size());
+			nodes.push_back(Node {prefix, {NO_NODE, NO_NODE}, entry, static_cast<uint8_t>(length)});
+			return;
+		}
+		auto child_length = nodes[child].length;
+		auto common = std::min<uint32_t>(commonPrefixLength(prefix, nodes[child].prefix),
+		                                 std::min<uint32_t>(length, child_length));
+		if (common == child_length) {
+			current = child;
+			continue;
+		}
+
+		// The block ends or branches off within the path compressed into `child`
+		auto split = static_cast<uint32_t>(nodes.size());
+		nodes[current].children[branch] = split;
+		if (common == length) {
+			Node node {prefix, {NO_NODE, NO_NODE}, entry, static_cast<uint8_t>(length)};
+			node.children[bitAt(nodes[child].prefix, length)] = child;
+			nodes.push_back(node);
+			return;
+		}
+		Node node {clearHostBits(prefix, common), {NO_NODE, NO_NODE}, 0, static_cast<uint8_t>(common)};
+		node.children[bitAt(nodes[child].prefix, common)] = child;
+		node.children[bitAt(prefix, common)] = split + 1;
+		nodes.push_back(node);
+		nodes.push_back(Node {prefix, {NO_NODE, NO_NODE}, entry, static_cast<uint8_t>(length)});
+		return;
+	}
+}
+
+uint32_t IPPrefixIndex::lookupTrie(uhugeint_t address) const {
+	uint32_t found = 0;
+	uint32_t current = 0;
+	while (true) {
+		auto &node = nodes[current];
+		if (commonPrefixLength(address, node.prefix) < node.length) {
+			break;
+		}
+		if (node.payload != 0) {
+			found = node.payload;
+		}
+		if (node.length == 128) {
+			break;
+		}
+		current = node.children[bitAt(address, node.length)];
+		if (current == NO_NODE) {
+			break;
+		}
+	}
+	return found;
+}
+
+const std::string *IPPrefixIndex::lookup(uhugeint_t address) const {
+	if (!root.empty() && IsIPv4Address(address)) {
+		auto ip = static_cast<uint32_t>(address.lower);
+		auto entry = root[ip >> 16];
+		if (entry & CHILD) {
+			entry = tables[size_t(entry & ~CHILD) * 256 + ((ip >> 8) & 0xFF)];
+			if (entry & CHILD) {
+				entry = tables[size_t(entry & ~CHILD) * 256 + (ip & 0xFF)];
+			}
+		}
+		if (entry != 0) {
+			return &payloads[entry - 1];
+		}
+	}
+	auto entry = lookupTrie(address);
+	return entry == 0 ? nullptr : &payloads[entry - 1];
+}
+
+std::shared_ptr<const IPPrefixIndex> IPPrefixIndex::get(DatabaseInstance &db, const std::string &name) {
+	std::lock_guard<std::mutex> guard(named_indexes_lock);
+	auto &indexes = namedIndexes();
+	auto entry = indexes.find({&db, StringUtil::Lower(name)});
+	if (entry == indexes.end() || entry->second.database.lock().get() != &db) {
+		return nullptr;
+	}
+	return entry->second.index;
+}
+
+void IPPrefixIndex::publish(DatabaseInstance &db, const std::string &name,
+                            std::shared_ptr<const IPPrefixIndex> index) {
+	std::lock_guard<std::mutex> guard(named_indexes_lock);
+	auto &indexes = namedIndexes();
+	// Forget the indexes of closed databases
+	for (auto it = indexes.begin(); it != indexes.end();) {
+		it = it->second.database.expired() ? indexes.erase(it) : std::next(it);
+	}
+	// `index` is left with the previous index, which is released after the lock by whoever holds it last
+	auto &entry = indexes[{&db, StringUtil::Lower(name)}];
+	entry.database = db.shared_from_this();
+	entry.index.swap(index);
+}
+} // namespace duckdb::netquack
@@ -0,0 +1,73 @@
+// Copyright 2026 Arash Hatami
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "duckdb.hpp"
+#include "../functions/ip_functions.hpp"
+
+namespace duckdb::netquack {
+// Read-only longest-prefix-match map from CIDR blocks to payloads, shared by all threads and queries.
+// IPv4 blocks are expanded into DIR-16-8-8 tables: a lookup reads the entry of the first 16 bits and at most two
+// tables of 256 entries below it. All other blocks go into a path-compressed binary trie, a lookup visits at most
+// one node per bit of the longest block on its path. An IPv4 address that no IPv4 block covers falls back to the
+// trie, which holds the blocks such as ::/0 that cover IPv4-mapped addresses with a prefix shorter than /96.
+class IPPrefixIndex {
+public:
+	// Collects (block, payload) pairs. For a block added more than once, the payload added last wins.
+	class Builder {
+	public:
+		void add(const IPRange &range, std::string payload);
+		std::shared_ptr<const IPPrefixIndex> build();
+
+	private:
+		std::vector<std::pair<IPRange, uint32_t>> ranges;
+		std::vector<std::string> payloads;
+	};
+
+	// Payload of the longest block that contains `address`, nullptr if there is none
+	const std::string *lookup(uhugeint_t address) const;
+
+	// Number of distinct blocks
+	size_t size() const {
+		return block_count;
+	}
+
+	// Index created as `name` for `db` by create_ip_index, nullptr if there is none. Names are case-insensitive.
+	static std::shared_ptr<const IPPrefixIndex> get(DatabaseInstance &db, const std::string &name);
+	// Make `index` the index named `name` of `db`. Queries that already started keep the index they pinned.
+	static void publish(DatabaseInstance &db, const std::string &name, std::shared_ptr<const IPPrefixIndex> index);
+
+private:
+	// An entry of the IPv4 tables is 0 if no block covers it, the payload position plus one, or CHILD plus the
+	// number of the 256-entry table with the next 8 bits
+	static constexpr uint32_t CHILD = 0x80000000;
+	static constexpr uint32_t NO_NODE = 0;
+
+	struct Node {
+		uhugeint_t prefix;
+		uint32_t children[2];
+		// Payload position plus one, 0 for a node that only joins two branches
+		uint32_t payload;
+		uint8_t length;
+	};
+
+	void insertIPv4(uint32_t network, uint32_t length, uint32_t entry);
+	uint32_t addTable(uint32_t entry);
+	void insertTrie(const IPRange &range, uint32_t entry);
+	uint32_t lookupTrie(uhugeint_t address) const;
+
+	// 65536 entries for the first 16 bits, empty if there are no IPv4 blocks
+	std::vector<uint32_t> root;
+	// 256-entry tables for the bits 17 to 24 and 25 to 32, one after the other
+	std::vector<uint32_t> tables;
+	// Node 0 is the root of the trie, the block ::/0 if it has a payload
+	std::vector<Node> nodes;
+	std::vector<std::string> payloads;
+	size_t block_count = 0;
+};
+} // namespace duckdb::netquack
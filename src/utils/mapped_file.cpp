@@ -0,0 +1,64 @@
+// Copyright 2026 Arash Hatami
+
+#include "mapped_file.hpp"
+
+#ifdef _WIN32
+#include <fstream>
+#include <sstream>
+#else // POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace duckdb::netquack {
+std::unique_ptr<MappedFile> MappedFile::open(const std::string &path) {
+	std::unique_ptr<MappedFile> file(new MappedFile());
+#ifdef _WIN32
+	std::ifstream input(path, std::ios::binary);
+	if (!input) {
+		return nullptr;
+	}
+	std::ostringstream buffer;
+	buffer << input.rdbuf();
+	file->contents = buffer.str();
+	file->data_start = file->contents.data();
+	file->data_size = file->contents.size();
+#else // POSIX
+	int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		return nullptr;
+	}
+	struct stat info;
+	if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+		close(fd);
+		return nullptr;
+	}
+	if (info.st_size > 0) {
+		void *mapping = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+		if (mapping == MAP_FAILED) {
+			close(fd);
+			return nullptr;
+		}
+#ifdef MADV_RANDOM
+		// Lookups jump around the file, reading ahead would only pull in pages nobody asked for
+		madvise(mapping, static_cast<size_t>(info.st_size), MADV_RANDOM);
+#endif
+		file->data_start = static_cast<const char *>(mapping);
+		file->data_size = static_cast<size_t>(info.st_size);
+	}
+	// The mapping keeps its own reference to the file
+	close(fd);
+#endif
+	return file;
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+	if (data_start) {
+		munmap(const_cast<char *>(data_start), data_size);
+	}
+#endif
+}
+} // namespace duckdb::netquack
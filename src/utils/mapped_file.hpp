@@ -0,0 +1,36 @@
+// Copyright 2026 Arash Hatami
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace duckdb::netquack {
+// Read-only view of a whole file. On POSIX the file is mapped, so pages are only read when they are touched and
+// processes mapping the same file share the page cache. Elsewhere the file is read into memory.
+class MappedFile {
+public:
+	// nullptr if the file cannot be opened or mapped
+	static std::unique_ptr<MappedFile> open(const std::string &path);
+	~MappedFile();
+
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	const char *data() const {
+		return data_start;
+	}
+	size_t size() const {
+		return data_size;
+	}
+
+private:
+	MappedFile() = default;
+
+	const char *data_start = nullptr;
+	size_t data_size = 0;
+	// Contents of the file where it is not mapped
+	std::string contents;
+};
+} // namespace duckdb::netquack
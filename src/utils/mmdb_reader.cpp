@@ -0,0 +1,353 @@
+// Copyright 2026 Arash Hatami
+
+#include "mmdb_reader.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <mutex>
+
+#include "../functions/ip_functions.hpp"
+
+namespace duckdb::netquack {
+namespace {
+constexpr char METADATA_MARKER[] = "\xAB\xCD\xEF"
+                                   "MaxMind.com";
+constexpr size_t METADATA_MARKER_SIZE = sizeof(METADATA_MARKER) - 1;
+// The metadata is within this many bytes of the end of the file
+constexpr size_t METADATA_MAX_SIZE = 128 * 1024;
+// Zero bytes between the search tree and the data section
+constexpr size_t DATA_SECTION_SEPARATOR = 16;
+// Nesting limit for skipping values of broken files
+constexpr int MAX_DEPTH = 64;
+
+enum DataType : uint32_t {
+	TYPE_EXTENDED = 0,
+	TYPE_POINTER = 1,
+	TYPE_STRING = 2,
+	TYPE_DOUBLE = 3,
+	TYPE_BYTES = 4,
+	TYPE_UINT16 = 5,
+	TYPE_UINT32 = 6,
+	TYPE_MAP = 7,
+	TYPE_INT32 = 8,
+	TYPE_UINT64 = 9,
+	TYPE_UINT128 = 10,
+	TYPE_ARRAY = 11,
+	TYPE_CONTAINER = 12,
+	TYPE_END_MARKER = 13,
+	TYPE_BOOLEAN = 14,
+	TYPE_FLOAT = 15,
+};
+
+// Reader of one file, with what it was opened from
+struct CachedReader {
+	std::shared_ptr<const MMDBReader> reader;
+	std::filesystem::file_time_type modified;
+	uintmax_t size;
+};
+
+std::mutex readers_lock;
+
+std::map<std::string, CachedReader> &cachedReaders() {
+	static std::map<std::string, CachedReader> readers;
+	return readers;
+}
+
+uint32_t readBigEndian(const uint8_t *bytes, size_t count) {
+	uint32_t value = 0;
+	for (size_t i = 0; i < count; ++i) {
+		value = (value << 8) | bytes[i];
+	}
+	return value;
+}
+
+// Type and size of the value at `position`, which is moved to its payload. Pointers are returned as they are,
+// with the pointed to offset as size.
+bool readControl(const uint8_t *start, size_t end, size_t &position, uint32_t &type, uint32_t &size) {
+	if (position >= end) {
+		return false;
+	}
+	uint8_t control = start[position++];
+	type = control >> 5;
+	if (type == TYPE_POINTER) {
+		// 001SSVVV: SS + 1 more bytes, VVV are the upper bits except for four byte pointers
+		uint32_t bytes = ((control >> 3) & 3) + 1;
+		if (position + bytes > end) {
+			return false;
+		}
+		uint32_t value = readBigEndian(start + position, bytes);
+		position += bytes;
+		static constexpr uint32_t BIAS[] = {0, 2048, 526336, 0};
+		size = bytes == 4 ? value : ((uint32_t(control & 7) << (8 * bytes)) | value) + BIAS[bytes - 1];
+		return true;
+	}
+	if (type == TYPE_EXTENDED) {
+		if (position >= end) {
+			return false;
+		}
+		type = 7 + start[position++];
+	}
+	size = control & 0x1F;
+	if (size >= 29) {
+		// 29, 30 and 31 are followed by one, two and three more bytes of the size
+		static constexpr uint32_t BASE[] = {29, 285, 65821};
+		size_t bytes = size - 28;
+		if (position + bytes > end) {
+			return false;
+		}
+		size = BASE[bytes - 1] + readBigEndian(start + position, bytes);
+		position += bytes;
+	}
+	return true;
+}
+} // namespace
+
+std::shared_ptr<const MMDBReader> MMDBReader::open(const std::string &path, std::string &error) {
+	std::error_code status;
+	auto modified = std::filesystem::last_write_time(path, status);
+	auto size = status ? 0 : std::filesystem::file_size(path, status);
+	if (status) {
+		error = "GeoIP database `" + path + "` not found";
+		return nullptr;
+	}
+	{
+		std::lock_guard<std::mutex> guard(readers_lock);
+		auto cached = cachedReaders().find(path);
+		if (cached != cachedReaders().end() && cached->second.modified == modified && cached->second.size == size) {
+			return cached->second.reader;
+		}
+	}
+
+	// Opened outside of the lock, the file is only read where lookups go
+	std::shared_ptr<MMDBReader> reader(new MMDBReader());
+	reader->file = MappedFile::open(path);
+	if (!reader->file) {
+		error = "GeoIP database `" + path + "` can't be opened";
+		return nullptr;
+	}
+	auto start = reinterpret_cast<const uint8_t *>(reader->file->data());
+	auto file_size = reader->file->size();
+
+	// The metadata follows the last marker
+	size_t search_start = file_size > METADATA_MAX_SIZE ? file_size - METADATA_MAX_SIZE : 0;
+	size_t marker = std::string::npos;
+	for (size_t i = file_size >= METADATA_MARKER_SIZE ? file_size - METADATA_MARKER_SIZE + 1 : 0; i-- > search_start;) {
+		if (memcmp(start + i, METADATA_MARKER, METADATA_MARKER_SIZE) == 0) {
+			marker = i;
+			break;
+		}
+	}
+	auto invalid = "`" + path + "` is not a MaxMind DB file";
+	if (marker == std::string::npos) {
+		error = invalid;
+		return nullptr;
+	}
+	auto metadata_start = marker + METADATA_MARKER_SIZE;
+	if (!reader->parseMetadata(Section {start + metadata_start, file_size - metadata_start}, error)) {
+		error = invalid + ": " + error;
+		return nullptr;
+	}
+
+	// Search tree | 16 zero bytes | data section | marker | metadata
+	auto tree_size = uint64_t(reader->node_count) * reader->record_size / 4;
+	if (tree_size + DATA_SECTION_SEPARATOR > marker) {
+		error = invalid + ": the search tree is cut off";
+		return nullptr;
+	}
+	reader->tree = start;
+	reader->data = Section {start + tree_size + DATA_SECTION_SEPARATOR, marker - tree_size - DATA_SECTION_SEPARATOR};
+	if (reader->ip_version == 6) {
+		for (int i = 0; i < 96 && reader->ipv4_start < reader->node_count; ++i) {
+			reader->ipv4_start = reader->readRecord(reader->ipv4_start, 0);
+		}
+	}
+
+	std::lock_guard<std::mutex> guard(readers_lock);
+	auto &cached = cachedReaders()[path];
+	cached = CachedReader {reader, modified, size};
+	return cached.reader;
+}
+
+bool MMDBReader::parseMetadata(Section metadata, std::string &error) {
+	uint64_t value = 0;
+	Field field;
+	if (!walk(metadata, 0, {"binary_format_major_version"}, field) || !readUnsigned(metadata, field, value) ||
+	    value != 2) {
+		error = "only version 2 of the format is supported";
+		return false;
+	}
+	if (!walk(metadata, 0, {"node_count"}, field) || !readUnsigned(metadata, field, value) || value >= UINT32_MAX) {
+		error = "no node count";
+		return false;
+	}
+	node_count = static_cast<uint32_t>(value);
+	if (!walk(metadata, 0, {"record_size"}, field) || !readUnsigned(metadata, field, value) ||
+	    (value != 24 && value != 28 && value != 32)) {
+		error = "unsupported record size";
+		return false;
+	}
+	record_size = static_cast<uint32_t>(value);
+	if (!walk(metadata, 0, {"ip_version"}, field) || !readUnsigned(metadata, field, value) ||
+	    (value != 4 && value != 6)) {
+		error = "unsupported IP version";
+		return false;
+	}
+	ip_version = static_cast<uint32_t>(value);
+	if (walk(metadata, 0, {"database_type"}, field) && field.type == TYPE_STRING) {
+		database_type.assign(reinterpret_cast<const char *>(metadata.start + field.payload), field.size);
+	}
+	return true;
+}
+
+uint32_t MMDBReader::readRecord(uint32_t node, uint32_t bit) const {
+	switch (record_size) {
+	case 24: {
+		auto bytes = tree + size_t(node) * 6 + bit * 3;
+		return readBigEndian(bytes, 3);
+	}
+	case 28: {
+		// The middle byte holds the upper four bits of the left record, then those of the right one
+		auto bytes = tree + size_t(node) * 7;
+		if (bit == 0) {
+			return (uint32_t(bytes[3] & 0xF0) << 20) | readBigEndian(bytes, 3);
+		}
+		return (uint32_t(bytes[3] & 0x0F) << 24) | readBigEndian(bytes + 4, 3);
+	}
+	default:
+		return readBigEndian(tree + size_t(node) * 8 + bit * 4, 4);
+	}
+}
+
+bool MMDBReader::find(uhugeint_t address, uint32_t &record) const {
+	uint32_t node = 0;
+	int first_bit = 0;
+	if (IsIPv4Address(address)) {
+		node = ipv4_start;
+		first_bit = 96;
+	} else if (ip_version == 4) {
+		return false;
+	}
+	for (int i = first_bit; i < 128 && node < node_count; ++i) {
+		auto bit = i < 64 ? (address.upper >> (63 - i)) & 1 : (address.lower >> (127 - i)) & 1;
+		node = readRecord(node, static_cast<uint32_t>(bit));
+	}
+	// node_count itself means there is no record, smaller values are nodes the address ran out of bits in
+	if (node <= node_count) {
+		return false;
+	}
+	auto offset = uint64_t(node) - node_count - DATA_SECTION_SEPARATOR;
+	if (offset >= data.size) {
+		return false;
+	}
+	record = static_cast<uint32_t>(offset);
+	return true;
+}
+
+bool MMDBReader::resolve(Section section, size_t position, Field &field) {
+	if (!readControl(section.start, section.size, position, field.type, field.size)) {
+		return false;
+	}
+	if (field.type == TYPE_POINTER) {
+		// A pointer never points to another pointer
+		position = field.size;
+		if (!readControl(section.start, section.size, position, field.type, field.size) ||
+		    field.type == TYPE_POINTER) {
+			return false;
+		}
+	}
+	field.payload = position;
+	return true;
+}
+
+bool MMDBReader::skip(Section section, size_t &position, int depth) {
+	uint32_t type;
+	uint32_t size;
+	if (depth > MAX_DEPTH || !readControl(section.start, section.size, position, type, size)) {
+		return false;
+	}
+	switch (type) {
+	case TYPE_POINTER:
+		return true;
+	case TYPE_MAP:
+		for (uint64_t i = 0; i < uint64_t(size) * 2; ++i) {
+			if (!skip(section, position, depth + 1)) {
+				return false;
+			}
+		}
+		return true;
+	case TYPE_ARRAY:
+		for (uint32_t i = 0; i < size; ++i) {
+			if (!skip(section, position, depth + 1)) {
+				return false;
+			}
+		}
+		return true;
+	case TYPE_BOOLEAN:
+	case TYPE_CONTAINER:
+	case TYPE_END_MARKER:
+		// The size is the value, or there is none
+		return true;
+	default:
+		position += size;
+		return position <= section.size;
+	}
+}
+
+bool MMDBReader::walk(Section section, size_t position, std::initializer_list<std::string_view> path,
+                      Field &field) {
+	if (!resolve(section, position, field)) {
+		return false;
+	}
+	for (auto key : path) {
+		if (field.type != TYPE_MAP) {
+			return false;
+		}
+		position = field.payload;
+		bool found = false;
+		for (uint32_t i = 0; i < field.size && !found; ++i) {
+			Field name;
+			if (!resolve(section, position, name) || name.type != TYPE_STRING ||
+			    !skip(section, position, 0)) {
+				return false;
+			}
+			found = name.size == key.size() && name.payload + name.size <= section.size &&
+			        memcmp(section.start + name.payload, key.data(), key.size()) == 0;
+			if (!found && !skip(section, position, 0)) {
+				return false;
+			}
+		}
+		if (!found || !resolve(section, position, field)) {
+			return false;
+		}
+	}
+	return field.payload + (field.type == TYPE_MAP || field.type == TYPE_ARRAY ? 0 : field.size) <= section.size;
+}
+
+bool MMDBReader::readUnsigned(Section section, const Field &field, uint64_t &value) {
+	if ((field.type != TYPE_UINT16 && field.type != TYPE_UINT32 && field.type != TYPE_UINT64) || field.size > 8) {
+		return false;
+	}
+	value = 0;
+	for (uint32_t i = 0; i < field.size; ++i) {
+		value = (value << 8) | section.start[field.payload + i];
+	}
+	return true;
+}
+
+bool MMDBReader::lookupString(uint32_t record, std::initializer_list<std::string_view> path,
+                              std::string_view &value) const {
+	Field field;
+	if (!walk(data, record, path, field) || field.type != TYPE_STRING) {
+		return false;
+	}
+	value = std::string_view(reinterpret_cast<const char *>(data.start + field.payload), field.size);
+	return true;
+}
+
+bool MMDBReader::lookupUnsigned(uint32_t record, std::initializer_list<std::string_view> path,
+                                uint64_t &value) const {
+	Field field;
+	return walk(data, record, path, field) && readUnsigned(data, field, value);
+}
+} // namespace duckdb::netquack
@@ -0,0 +1,72 @@
+// Copyright 2026 Arash Hatami
+
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "duckdb.hpp"
+#include "mapped_file.hpp"
+
+namespace duckdb::netquack {
+// Read-only MaxMind DB (https://maxmind.github.io/MaxMind-DB/), such as GeoLite2-City or GeoLite2-ASN.
+// The file is mapped and used in place: a lookup walks the binary search tree bit by bit to the record of the
+// address, and only the values on the requested key paths are decoded. Everything else in the record is skipped.
+class MMDBReader {
+public:
+	// The reader of the file at `path`, shared by all queries of the process. The file is opened again when it
+	// changes on disk. nullptr if it can't be opened, `error` tells why.
+	static std::shared_ptr<const MMDBReader> open(const std::string &path, std::string &error);
+
+	// Data section offset of the record of `address` (see the IP type), false if the database has none.
+	// An IPv6 database has the IPv4 addresses in ::/96, an IPv4 database has no IPv6 addresses.
+	bool find(uhugeint_t address, uint32_t &record) const;
+
+	// Value at `path` in the map `record`, false if there is none or it is of another type
+	bool lookupString(uint32_t record, std::initializer_list<std::string_view> path, std::string_view &value) const;
+	bool lookupUnsigned(uint32_t record, std::initializer_list<std::string_view> path, uint64_t &value) const;
+
+	const std::string &databaseType() const {
+		return database_type;
+	}
+
+private:
+	MMDBReader() = default;
+
+	// A part of the file that values are decoded from, pointers are relative to its start
+	struct Section {
+		const uint8_t *start;
+		size_t size;
+	};
+	// Type, size and payload position of a value
+	struct Field {
+		uint32_t type;
+		uint32_t size;
+		size_t payload;
+	};
+
+	bool parseMetadata(Section metadata, std::string &error);
+	// Decode the value at `position` of `section`, following a pointer
+	static bool resolve(Section section, size_t position, Field &field);
+	// Move `position` past the value there, without following pointers
+	static bool skip(Section section, size_t &position, int depth);
+	// Value at `path` in the map at `position` of `section`
+	static bool walk(Section section, size_t position, std::initializer_list<std::string_view> path, Field &field);
+	static bool readUnsigned(Section section, const Field &field, uint64_t &value);
+
+	uint32_t readRecord(uint32_t node, uint32_t bit) const;
+
+	std::unique_ptr<MappedFile> file;
+	Section data {nullptr, 0};
+	const uint8_t *tree = nullptr;
+	uint32_t node_count = 0;
+	uint32_t record_size = 0;
+	uint32_t ip_version = 0;
+	// Node the IPv4 addresses start at, after the 96 zero bits of ::/96 in an IPv6 database
+	uint32_t ipv4_start = 0;
+	std::string database_type;
+};
+} // namespace duckdb::netquack
@@ -0,0 +1,58 @@
+// Copyright 2026 Arash Hatami
+
+#include "parse_failures.hpp"
+
+#include <map>
+#include <mutex>
+
+namespace duckdb::netquack {
+namespace {
+std::mutex totals_lock;
+
+std::map<std::string, uint64_t> &failureTotals() {
+	static std::map<std::string, uint64_t> totals;
+	return totals;
+}
+} // namespace
+
+ParseFailures::ParseFailures(ExpressionState &state, const char *function_name) : function_name(function_name) {
+	Value null_on_error_setting;
+	if (state.GetContext().TryGetCurrentSetting("netquack_null_on_error", null_on_error_setting) &&
+	    !null_on_error_setting.IsNull()) {
+		null_on_error = null_on_error_setting.GetValue<bool>();
+	}
+}
+
+ParseFailures::~ParseFailures() {
+	// Most chunks have no failures, they never take the lock
+	if (failure_count == 0) {
+		return;
+	}
+	std::lock_guard<std::mutex> guard(totals_lock);
+	failureTotals()[function_name] += failure_count;
+}
+
+void ParseFailures::countRows(const SelectionVector &sel, idx_t count, idx_t dictionary_size) {
+	recording = false;
+	if (failed_entries.empty()) {
+		return;
+	}
+	std::vector<bool> failed(dictionary_size, false);
+	for (auto entry : failed_entries) {
+		failed[entry] = true;
+	}
+	failed_entries.clear();
+	for (idx_t i = 0; i < count; ++i) {
+		failure_count += failed[sel.get_index(i)];
+	}
+}
+
+std::vector<ParseFailures::Total> ParseFailures::totals() {
+	std::vector<Total> result;
+	std::lock_guard<std::mutex> guard(totals_lock);
+	for (auto &entry : failureTotals()) {
+		result.push_back({entry.first, entry.second});
+	}
+	return result;
+}
+} // namespace duckdb::netquack
@@ -0,0 +1,61 @@
+// Copyright 2026 Arash Hatami
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "duckdb.hpp"
+
+namespace duckdb::netquack {
+// Malformed values seen by one scalar function on one chunk.
+// With `netquack_null_on_error` enabled the rows become NULL, otherwise they keep the function's fallback value
+// (e.g. an empty string). Either way no exception is thrown and no message is allocated per row, the count is
+// added to the process-wide totals once the chunk is done.
+class ParseFailures {
+public:
+	struct Total {
+		std::string function_name;
+		uint64_t failures;
+	};
+
+	// `function_name` must outlive the object, string literals are expected
+	ParseFailures(ExpressionState &state, const char *function_name);
+	~ParseFailures();
+
+	ParseFailures(const ParseFailures &) = delete;
+	ParseFailures &operator=(const ParseFailures &) = delete;
+
+	// Count row `idx` of `mask` as malformed, returns true if the row was set to NULL
+	bool fail(ValidityMask &mask, idx_t idx) {
+		if (recording) {
+			failed_entries.push_back(idx);
+		} else {
+			++failure_count;
+		}
+		if (null_on_error) {
+			mask.SetInvalid(idx);
+		}
+		return null_on_error;
+	}
+
+	// Keep the indexes of failed dictionary entries instead of counting them, for countRows
+	void recordEntries() {
+		recording = true;
+	}
+	// Count every row of `sel` that refers to a failed entry of a dictionary of `dictionary_size` entries, so rows
+	// are counted as often as they occur and entries that no row refers to are not counted
+	void countRows(const SelectionVector &sel, idx_t count, idx_t dictionary_size);
+
+	// Totals per function since the extension was loaded, ordered by function name
+	static std::vector<Total> totals();
+
+private:
+	const char *function_name;
+	bool null_on_error = false;
+	uint64_t failure_count = 0;
+	bool recording = false;
+	std::vector<idx_t> failed_entries;
+};
+} // namespace duckdb::netquack
@@ -0,0 +1,80 @@
+// Copyright 2026 Arash Hatami
+
+#include "table_scan.hpp"
+
+#include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/storage/data_table.hpp"
+#include "duckdb/storage/table/scan_state.hpp"
+#include "duckdb/transaction/duck_transaction.hpp"
+#include "logger.hpp"
+#include "utils.hpp"
+
+namespace duckdb::netquack {
+namespace {
+void QueryTable(ClientContext &context, TableCatalogEntry &table, const vector<std::string> &columns,
+                const vector<LogicalType> &types, const std::function<void(DataChunk &chunk)> &consume) {
+	std::string select;
+	for (idx_t i = 0; i < columns.size(); ++i) {
+		select += (i == 0 ? "" : ", ") + QuoteIdentifier(columns[i]) + "::" + types[i].ToString();
+	}
+	Connection con(*context.db);
+	auto result = con.Query("SELECT " + select + " FROM " + QuoteIdentifier(table.ParentCatalog().GetName()) + "." +
+	                        QuoteIdentifier(table.ParentSchema().name) + "." + QuoteIdentifier(table.name));
+	if (result->HasError()) {
+		LogMessage(LogLevel::LOG_CRITICAL, result->GetError());
+	}
+	while (auto chunk = result->Fetch()) {
+		consume(*chunk);
+	}
+}
+} // namespace
+
+void ScanTable(ClientContext &context, TableCatalogEntry &table, const vector<std::string> &columns,
+               const vector<LogicalType> &types, const std::function<void(DataChunk &chunk)> &consume) {
+	vector<StorageIndex> column_ids;
+	vector<LogicalType> column_types;
+	for (auto &name : columns) {
+		if (!table.ColumnExists(name)) {
+			LogMessage(LogLevel::LOG_CRITICAL, "Table `" + table.name + "` has no column `" + name + "`");
+		}
+		auto &column = table.GetColumn(name);
+		if (column.Generated()) {
+			LogMessage(LogLevel::LOG_CRITICAL,
+			           "Column `" + name + "` of table `" + table.name + "` is generated, it can't be read");
+		}
+		column_ids.emplace_back(column.StorageOid());
+		column_types.push_back(column.Type());
+	}
+	if (!table.IsDuckTable()) {
+		QueryTable(context, table, columns, types, consume);
+		return;
+	}
+
+	auto &storage = table.GetStorage();
+	auto &transaction = DuckTransaction::Get(context, table.ParentCatalog());
+	TableScanState scan_state;
+	storage.InitializeScan(context, transaction, scan_state, column_ids);
+
+	DataChunk scanned;
+	DataChunk cast;
+	scanned.Initialize(Allocator::Get(context), column_types);
+	cast.Initialize(Allocator::Get(context), types);
+	while (true) {
+		scanned.Reset();
+		storage.Scan(transaction, scanned, scan_state);
+		if (scanned.size() == 0) {
+			return;
+		}
+		cast.Reset();
+		for (idx_t i = 0; i < types.size(); ++i) {
+			if (column_types[i] == types[i]) {
+				cast.data[i].Reference(scanned.data[i]);
+			} else {
+				VectorOperations::Cast(context, scanned.data[i], cast.data[i], scanned.size());
+			}
+		}
+		cast.SetCardinality(scanned.size());
+		consume(cast);
+	}
+}
+} // namespace duckdb::netquack
@@ -0,0 +1,18 @@
+// Copyright 2026 Arash Hatami
+
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include "duckdb.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+
+namespace duckdb::netquack {
+// Read `columns` of `table` cast to `types` and pass them to `consume` one chunk at a time.
+// The rows are the ones the transaction of `context` sees, its own uncommitted changes included, and the table
+// can be read while a query of `context` is running. Tables of other catalogs (e.g. an attached Postgres database)
+// are read through a query on a separate connection instead.
+void ScanTable(ClientContext &context, TableCatalogEntry &table, const vector<std::string> &columns,
+               const vector<LogicalType> &types, const std::function<void(DataChunk &chunk)> &consume);
+} // namespace duckdb::netquack
@@ -1,58 +1,289 @@
-// Auto-generated from Mozilla Public Suffix List using gperf
+// Copyright 2026 Arash Hatami
 
 #include "tld_lookup.hpp"
 
+#include <atomic>
+#include <map>
+#include <memory>
+
 #include "tld_lookup_generated.hpp"
+#include "url_helpers.hpp"
 
 namespace duckdb::netquack {
-bool isValidTLD(const char *str, size_t len) {
-	return TLDLookupHash::isValidTLD(str, static_cast<unsigned int>(len)) != nullptr;
+namespace {
+// Node of the trie while it is being built, flattened into PublicSuffixList::Node afterwards
+struct BuildNode {
+	std::map<std::string, std::unique_ptr<BuildNode>> children;
+	uint8_t flags = 0;
+};
+
+// Compare two labels bytewise, hosts are folded to lower case before the walk.
+// Labels are a few bytes long, an inline loop beats a call to memcmp.
+int compareLabel(std::string_view stored, std::string_view label) {
+	size_t length = std::min(stored.size(), label.size());
+	for (size_t i = 0; i < length; ++i) {
+		auto a = static_cast<unsigned char>(stored[i]);
+		auto b = static_cast<unsigned char>(label[i]);
+		if (a != b) {
+			return a < b ? -1 : 1;
+		}
+	}
+	if (stored.size() == label.size()) {
+		return 0;
+	}
+	return stored.size() < label.size() ? -1 : 1;
 }
 
-bool isValidTLD(const std::string &suffix) {
-	return isValidTLD(suffix.c_str(), suffix.length());
+// Lower-case copy of a host. Any valid DNS name (up to 255 bytes) fits in the stack buffer,
+// longer garbage hosts fall back to the heap.
+class LowerHost {
+public:
+	explicit LowerHost(std::string_view host) {
+		char *out = buffer;
+		if (host.size() > sizeof(buffer)) {
+			overflow.reset(new char[host.size()]);
+			out = overflow.get();
+		}
+		simd::toLower(host.data(), host.data() + host.size(), out);
+		view = std::string_view(out, host.size());
+	}
+
+	std::string_view view;
+
+private:
+	char buffer[255];
+	std::unique_ptr<char[]> overflow;
+};
+} // namespace
+
+PublicSuffixList::PublicSuffixList(const std::vector<std::string_view> &rules) {
+	static std::atomic<uint64_t> next_list_id {1};
+	list_id = next_list_id++;
+
+	BuildNode root;
+	for (auto rule : rules) {
+		uint8_t flag = RULE;
+		if (!rule.empty() && rule.front() == '!') {
+			flag = EXCEPTION;
+			rule.remove_prefix(1);
+		} else if (rule.size() > 2 && rule[0] == '*' && rule[1] == '.') {
+			flag = WILDCARD;
+			rule.remove_prefix(2);
+		}
+		if (rule.empty()) {
+			continue;
+		}
+		++rule_count;
+
+		// Insert the labels right-to-left
+		BuildNode *node = &root;
+		size_t label_end = rule.size();
+		while (true) {
+			size_t dot = rule.rfind('.', label_end - 1);
+			size_t label_start = dot == std::string_view::npos ? 0 : dot + 1;
+			std::string label(rule.substr(label_start, label_end - label_start));
+			for (auto &c : label) {
+				c = toLowerASCII(c);
+			}
+			auto &child = node->children[label];
+			if (!child) {
+				child = std::make_unique<BuildNode>();
+			}
+			node = child.get();
+			if (dot == std::string_view::npos || dot == 0) {
+				break;
+			}
+			label_end = dot;
+		}
+		node->flags |= flag;
+	}
+
+	// Flatten breadth-first so the children of every node are contiguous and sorted
+	std::vector<const BuildNode *> queue {&root};
+	nodes.push_back({0, 0, 0, 0, root.flags});
+	for (size_t i = 0; i < queue.size(); ++i) {
+		auto &build_node = *queue[i];
+		nodes[i].first_child = static_cast<uint32_t>(nodes.size());
+		nodes[i].child_count = static_cast<uint32_t>(build_node.children.size());
+		for (auto &entry : build_node.children) {
+			nodes.push_back({static_cast<uint32_t>(labels.size()), static_cast<uint32_t>(entry.first.size()), 0, 0,
+			                 entry.second->flags});
+			labels += entry.first;
+			queue.push_back(entry.second.get());
+		}
+	}
 }
 
-std::string getEffectiveTLD(const std::string &hostname) {
-	if (hostname.empty()) {
-		return "";
+const PublicSuffixList::Node *PublicSuffixList::findChild(const Node &node, std::string_view label) const {
+	size_t low = node.first_child;
+	size_t high = node.first_child + node.child_count;
+	while (low < high) {
+		size_t mid = (low + high) / 2;
+		auto &candidate = nodes[mid];
+		int cmp = compareLabel(std::string_view(labels.data() + candidate.label_offset, candidate.label_length), label);
+		if (cmp == 0) {
+			return &candidate;
+		}
+		if (cmp < 0) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
 	}
+	return nullptr;
+}
+
+size_t PublicSuffixList::matchSuffix(std::string_view host) const {
+	size_t suffix_start = std::string_view::npos;
+	if (host.empty()) {
+		return suffix_start;
+	}
+
+	// Only the host is folded, offsets into the copy are offsets into `host`
+	LowerHost lower_host(host);
+	host = lower_host.view;
 
-	// Implement proper public suffix algorithm:
-	// Find the longest matching public suffix
+	// Walk the labels right-to-left, the deepest rule that matches is the longest one
+	const Node *node = &nodes[0];
+	const char *data = host.data();
+	const char *label_end = data + host.size();
+	while (true) {
+		const char *dot = find_last_symbols_or_null<'.'>(data, label_end);
+		const char *label_start = dot ? dot + 1 : data;
+		std::string_view label(label_start, label_end - label_start);
 
-	// First check if the entire hostname is a TLD
-	if (isValidTLD(hostname)) {
-		return hostname;
+		const Node *child = findChild(*node, label);
+		if (child && (child->flags & EXCEPTION) && label_end < data + host.size()) {
+			// Exception rules win over everything, the suffix is the exception minus its leftmost label
+			return label_end + 1 - data;
+		}
+		if ((node->flags & WILDCARD) && !label.empty()) {
+			suffix_start = label_start - data;
+		}
+		if (!child) {
+			break;
+		}
+		if (child->flags & RULE) {
+			suffix_start = label_start - data;
+		}
+		if (!dot) {
+			break;
+		}
+		node = child;
+		label_end = dot;
+	}
+	return suffix_start;
+}
+
+std::string_view PublicSuffixList::getPublicSuffix(std::string_view host) const {
+	size_t suffix_start = matchSuffix(host);
+	if (suffix_start == std::string_view::npos) {
+		// Default "*" rule: the last label
+		const char *last_dot = find_last_symbols_or_null<'.'>(host.data(), host.data() + host.size());
+		return last_dot ? host.substr(last_dot + 1 - host.data()) : host;
 	}
+	return host.substr(suffix_start);
+}
 
-	// Try all possible suffixes and find the longest match
-	std::string longest_tld;
+bool PublicSuffixList::isPublicSuffix(std::string_view host) const {
+	return !host.empty() && matchSuffix(host) == 0;
+}
 
-	for (size_t pos = 0; pos < hostname.length(); ++pos) {
-		if (hostname[pos] == '.') {
-			std::string candidate = hostname.substr(pos + 1);
-			if (isValidTLD(candidate)) {
-				// Keep the longest match
-				if (candidate.length() > longest_tld.length()) {
-					longest_tld = candidate;
-				}
-			}
+std::vector<std::string_view> PublicSuffixList::parseRules(std::string_view text) {
+	std::vector<std::string_view> rules;
+	size_t line_start = 0;
+	while (line_start < text.size()) {
+		size_t line_end = text.find('\n', line_start);
+		if (line_end == std::string_view::npos) {
+			line_end = text.size();
+		}
+		auto line = text.substr(line_start, line_end - line_start);
+		line_start = line_end + 1;
+
+		// A rule is the first whitespace-delimited token of a line
+		size_t rule_start = line.find_first_not_of(" \t\r");
+		if (rule_start == std::string_view::npos) {
+			continue;
+		}
+		line.remove_prefix(rule_start);
+		line = line.substr(0, line.find_first_of(" \t\r"));
+		if (line.compare(0, 2, "//") == 0) {
+			continue;
 		}
+		rules.push_back(line);
+	}
+	return rules;
+}
+
+const PublicSuffixList &PublicSuffixList::builtin() {
+	static const PublicSuffixList list(
+	    std::vector<std::string_view>(std::begin(PUBLIC_SUFFIX_RULES), std::end(PUBLIC_SUFFIX_RULES)));
+	return list;
+}
+
+namespace {
+std::shared_ptr<const PublicSuffixList> &currentList() {
+	// Does not own the built-in list, which lives until the extension is unloaded
+	static std::shared_ptr<const PublicSuffixList> list(std::shared_ptr<const PublicSuffixList>(),
+	                                                    &PublicSuffixList::builtin());
+	return list;
+}
+} // namespace
+
+std::shared_ptr<const PublicSuffixList> PublicSuffixList::current() {
+	return std::atomic_load(&currentList());
+}
+
+void PublicSuffixList::install(std::shared_ptr<const PublicSuffixList> list) {
+	std::atomic_store(&currentList(), std::move(list));
+}
+
+bool isValidTLD(std::string_view suffix, const PublicSuffixList &list) {
+	return list.isPublicSuffix(suffix);
+}
+
+bool isValidTLD(std::string_view suffix) {
+	return isValidTLD(suffix, *PublicSuffixList::current());
+}
+
+std::string_view getEffectiveTLD(std::string_view hostname, const PublicSuffixList &list) {
+	if (hostname.empty()) {
+		return {};
 	}
+	return list.getPublicSuffix(hostname);
+}
+
+std::string_view getEffectiveTLD(std::string_view hostname) {
+	return getEffectiveTLD(hostname, *PublicSuffixList::current());
+}
+
+DomainParts splitDomain(std::string_view hostname, const PublicSuffixList &list) {
+	DomainParts parts;
+	parts.tld = getEffectiveTLD(hostname, list);
+	parts.domain = hostname;
 
-	// If we found a valid TLD, return it
-	if (!longest_tld.empty()) {
-		return longest_tld;
+	// The suffix is either the whole host or preceded by a dot. An empty last label has no suffix.
+	size_t tld_start = hostname.size() - parts.tld.size();
+	if (parts.tld.empty() || tld_start == 0) {
+		return parts;
+	}
+	if (tld_start == 1) {
+		// ".co.uk" has an empty label before the suffix
+		parts.domain = parts.tld;
+		return parts;
 	}
 
-	// If no valid TLD found, return the last part after the last dot
-	size_t last_dot = hostname.find_last_of('.');
-	if (last_dot != std::string::npos) {
-		return hostname.substr(last_dot + 1);
+	// The registrable domain is one label more than the suffix
+	const char *domain_dot = find_last_symbols_or_null<'.'>(hostname.data(), hostname.data() + tld_start - 1);
+	if (domain_dot) {
+		size_t domain_start = domain_dot + 1 - hostname.data();
+		parts.subdomain = hostname.substr(0, domain_start - 1);
+		parts.domain = hostname.substr(domain_start);
 	}
+	return parts;
+}
 
-	// No dots, return entire hostname
-	return hostname;
+DomainParts splitDomain(std::string_view hostname) {
+	return splitDomain(hostname, *PublicSuffixList::current());
 }
 } // namespace duckdb::netquack
@@ -1,15 +1,84 @@
-// Auto-generated from Mozilla Public Suffix List using gperf
+// Copyright 2026 Arash Hatami
 
 #pragma once
 
-#include <cstring>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace duckdb::netquack {
-// Check if a suffix is a valid public suffix (TLD) using perfect hash
-bool isValidTLD(const char *str, size_t len);
-bool isValidTLD(const std::string &suffix);
+// Public suffix list compiled into a trie keyed on reversed labels ("com" -> "example" -> ...).
+// Supports plain, wildcard (*.) and exception (!) rules.
+// Lookups fold the host into a stack buffer and walk it right-to-left.
+class PublicSuffixList {
+public:
+	// Compile a list of rules in public suffix list syntax
+	explicit PublicSuffixList(const std::vector<std::string_view> &rules);
 
-// Get the effective TLD for a hostname
-std::string getEffectiveTLD(const std::string &hostname);
+	// Get the public suffix of a (lower-case or mixed-case) host, using the "*" default rule if nothing matches
+	std::string_view getPublicSuffix(std::string_view host) const;
+	// Check if the whole host is a public suffix according to an explicit rule
+	bool isPublicSuffix(std::string_view host) const;
+
+	// Number of rules the list was compiled from
+	size_t size() const {
+		return rule_count;
+	}
+	// Unique for every list compiled by the process, unlike its address
+	uint64_t id() const {
+		return list_id;
+	}
+
+	// Split the contents of a public_suffix_list.dat file into rules, dropping comments and blank lines
+	static std::vector<std::string_view> parseRules(std::string_view text);
+
+	// The list compiled into the extension
+	static const PublicSuffixList &builtin();
+	// The list used by the domain functions, the built-in one until another list is installed.
+	// Callers keep the returned pointer for as long as they use the list (e.g. for a whole chunk).
+	static std::shared_ptr<const PublicSuffixList> current();
+	// Atomically replace the current list, queries that already hold the previous one keep using it
+	static void install(std::shared_ptr<const PublicSuffixList> list);
+
+private:
+	enum : uint8_t { RULE = 1, WILDCARD = 2, EXCEPTION = 4 };
+
+	struct Node {
+		uint32_t label_offset;
+		uint32_t label_length;
+		uint32_t first_child;
+		uint32_t child_count;
+		uint8_t flags;
+	};
+
+	const Node *findChild(const Node &node, std::string_view label) const;
+	// Start of the public suffix in `host`, or npos if no explicit rule matched
+	size_t matchSuffix(std::string_view host) const;
+
+	std::vector<Node> nodes;
+	std::string labels;
+	size_t rule_count = 0;
+	uint64_t list_id;
+};
+
+// A host split around its registrable domain, every part is a view into the host
+struct DomainParts {
+	std::string_view subdomain; // "www" in "www.example.co.uk", empty if there is none
+	std::string_view domain;    // "example.co.uk", the registrable domain
+	std::string_view tld;       // "co.uk", the public suffix
+};
+
+// Check if a suffix is a valid public suffix (TLD)
+bool isValidTLD(std::string_view suffix, const PublicSuffixList &list);
+bool isValidTLD(std::string_view suffix);
+
+// Get the effective TLD for a hostname, as a view into `hostname`
+std::string_view getEffectiveTLD(std::string_view hostname, const PublicSuffixList &list);
+std::string_view getEffectiveTLD(std::string_view hostname);
+
+// Split a hostname using the public suffix list. A host that is a public suffix is its own domain.
+DomainParts splitDomain(std::string_view hostname, const PublicSuffixList &list);
+DomainParts splitDomain(std::string_view hostname);
 } // namespace duckdb::netquack
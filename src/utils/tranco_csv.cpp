@@ -0,0 +1,62 @@
+// Copyright 2026 Arash Hatami
+
+#include "tranco_csv.hpp"
+
+#include <cstring>
+
+namespace duckdb::netquack {
+void TrancoCsvParser::feed(const char *data, size_t size) {
+	const char *end = data + size;
+	if (!partial_line.empty()) {
+		auto newline = static_cast<const char *>(std::memchr(data, '\n', size));
+		if (!newline) {
+			partial_line.append(data, size);
+			return;
+		}
+		partial_line.append(data, newline - data);
+		parseLine(partial_line);
+		partial_line.clear();
+		data = newline + 1;
+	}
+
+	while (data < end) {
+		auto newline = static_cast<const char *>(std::memchr(data, '\n', end - data));
+		if (!newline) {
+			partial_line.assign(data, end - data);
+			return;
+		}
+		parseLine(std::string_view(data, newline - data));
+		data = newline + 1;
+	}
+}
+
+void TrancoCsvParser::finish() {
+	if (!partial_line.empty()) {
+		parseLine(partial_line);
+		partial_line.clear();
+	}
+}
+
+void TrancoCsvParser::parseLine(std::string_view line) {
+	if (!line.empty() && line.back() == '\r') {
+		line.remove_suffix(1);
+	}
+	if (line.empty()) {
+		return;
+	}
+
+	uint64_t rank = 0;
+	size_t pos = 0;
+	while (pos < line.size() && line[pos] >= '0' && line[pos] <= '9' && rank <= UINT32_MAX) {
+		rank = rank * 10 + (line[pos] - '0');
+		++pos;
+	}
+	if (pos == 0 || pos + 1 >= line.size() || line[pos] != ',' || rank == 0 || rank > UINT32_MAX) {
+		++malformed_count;
+		return;
+	}
+
+	++row_count;
+	on_row(static_cast<uint32_t>(rank), line.substr(pos + 1));
+}
+} // namespace duckdb::netquack
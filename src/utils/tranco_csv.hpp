@@ -0,0 +1,44 @@
+// Copyright 2026 Arash Hatami
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace duckdb::netquack {
+// Incremental parser of a Tranco list in CSV form (`rank,domain` lines), fed with the chunks of a download as they
+// arrive. Complete lines are parsed in place, only a line split between two chunks is copied.
+class TrancoCsvParser {
+public:
+	using RowCallback = std::function<void(uint32_t rank, std::string_view domain)>;
+
+	explicit TrancoCsvParser(RowCallback on_row) : on_row(std::move(on_row)) {
+	}
+
+	void feed(const char *data, size_t size);
+	// Parse the last line if the input does not end with a newline
+	void finish();
+
+	// Rows passed to the callback
+	uint64_t rows() const {
+		return row_count;
+	}
+	// Non-empty lines that are not `rank,domain` with a positive rank, they are skipped
+	uint64_t malformed() const {
+		return malformed_count;
+	}
+
+	// First error thrown by the callback during a download, empty if there was none
+	std::string error;
+
+private:
+	void parseLine(std::string_view line);
+
+	RowCallback on_row;
+	std::string partial_line;
+	uint64_t row_count = 0;
+	uint64_t malformed_count = 0;
+};
+} // namespace duckdb::netquack
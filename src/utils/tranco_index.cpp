@@ -0,0 +1,583 @@
+// Copyright 2026 Arash Hatami
+
+#include "tranco_index.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/main/client_context_state.hpp"
+#include "duckdb/main/config.hpp"
+#include "logger.hpp"
+#include "table_scan.hpp"
+#include "url_helpers.hpp"
+
+namespace duckdb::netquack {
+namespace {
+// The index of the snapshot named by a `tranco_list` table
+struct TableIndex {
+	// Tells a database apart from a later one at the same address
+	std::weak_ptr<DatabaseInstance> database;
+	idx_t table_oid;
+	std::string snapshot;
+	std::shared_ptr<const TrancoIndex> index;
+};
+
+// Start of a snapshot file. Bump SNAPSHOT_VERSION whenever the layout or TrancoIndex::hash changes.
+struct SnapshotHeader {
+	char magic[8];
+	uint32_t version;
+	// SNAPSHOT_BYTE_ORDER as written by the saving machine
+	uint32_t byte_order;
+	uint64_t slot_count;
+	uint64_t domain_count;
+	uint64_t arena_size;
+	// Date of the list, NUL terminated
+	char list_date[16];
+	// The slots are followed by `filter_count` filter layouts and then by all their fingerprints
+	uint64_t filter_count;
+	uint64_t fingerprint_size;
+	uint64_t checksum;
+};
+static_assert(sizeof(SnapshotHeader) == 80, "the slots must follow the header without padding");
+static_assert(sizeof(BinaryFuseFilter::Layout) == 24, "the filter layouts must follow the slots without padding");
+
+constexpr char SNAPSHOT_MAGIC[8] = {'N', 'Q', 'T', 'R', 'A', 'N', 'C', 'O'};
+constexpr uint32_t SNAPSHOT_VERSION = 3;
+constexpr uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+
+// Last rank of every bucket but "other"
+constexpr uint32_t BUCKET_ENDS[] = {1000, 5000, 10000, 50000, 100000, 500000, 1000000, 5000000};
+static_assert(TrancoIndex::FILTERED_CATEGORIES <= sizeof(BUCKET_ENDS) / sizeof(BUCKET_ENDS[0]), "unknown bucket");
+
+// Published snapshot index of every catalog, by database and catalog name. The lock only guards swapping the
+// pointers, indexes are opened and dropped outside of it, and an index lives on until the last query that pinned it
+// is done.
+// The registries are built when the library is loaded rather than on first use, so they are destroyed after the
+// background refreshes that publish to them are stopped at exit.
+std::mutex table_indexes_lock;
+std::map<std::pair<const DatabaseInstance *, std::string>, TableIndex> table_indexes;
+
+std::map<std::pair<const DatabaseInstance *, std::string>, TableIndex> &tableIndexes() {
+	return table_indexes;
+}
+
+// Drop the entries of closed databases, their indexes are moved to `released` to be freed after the lock
+void pruneIndexes(std::vector<std::shared_ptr<const TrancoIndex>> &released) {
+	auto &indexes = tableIndexes();
+	for (auto it = indexes.begin(); it != indexes.end();) {
+		if (it->second.database.expired()) {
+			released.push_back(std::move(it->second.index));
+			it = indexes.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+std::shared_ptr<const TrancoIndex> publishedIndex(DatabaseInstance &db, TableCatalogEntry &table,
+                                                  const std::string &snapshot) {
+	std::vector<std::shared_ptr<const TrancoIndex>> released;
+	std::lock_guard<std::mutex> guard(table_indexes_lock);
+	// The list of a closed database is released by the next lookup in any other one
+	pruneIndexes(released);
+	auto &indexes = tableIndexes();
+	auto entry = indexes.find({&db, table.ParentCatalog().GetName()});
+	// A replaced or commented table is a new catalog entry with a new oid
+	if (entry == indexes.end() || entry->second.database.lock().get() != &db || entry->second.table_oid != table.oid ||
+	    entry->second.snapshot != snapshot) {
+		return nullptr;
+	}
+	return entry->second.index;
+}
+
+void publishIndex(DatabaseInstance &db, TableCatalogEntry &table, const std::string &snapshot,
+                  std::shared_ptr<const TrancoIndex> index) {
+	std::vector<std::shared_ptr<const TrancoIndex>> released;
+	std::lock_guard<std::mutex> guard(table_indexes_lock);
+	pruneIndexes(released);
+	auto &indexes = tableIndexes();
+	// `index` is left with the previous index, which is released after the lock by whoever holds it last
+	auto &entry = indexes[{&db, table.ParentCatalog().GetName()}];
+	entry.database = db.shared_from_this();
+	entry.table_oid = table.oid;
+	entry.snapshot = snapshot;
+	entry.index.swap(index);
+}
+
+// Index of a `tranco_list` table without a snapshot, built by the first thread of a query that needs it and shared by
+// the others until the query ends
+struct TrancoQueryState : public ClientContextState {
+	void QueryEnd() override {
+		std::lock_guard<std::mutex> guard(lock);
+		index.reset();
+	}
+
+	std::mutex lock;
+	idx_t table_oid = 0;
+	std::shared_ptr<const TrancoIndex> index;
+};
+
+std::shared_ptr<const TrancoIndex> queryIndex(ClientContext &context, TableCatalogEntry &table) {
+	auto state = context.registered_state->GetOrCreate<TrancoQueryState>("netquack_tranco_query");
+	std::lock_guard<std::mutex> guard(state->lock);
+	if (!state->index || state->table_oid != table.oid) {
+		state->index = TrancoIndex::load(context, table, "");
+		state->table_oid = table.oid;
+	}
+	return state->index;
+}
+
+// Add the (domain, rank) rows of `chunk` to `builder`, skipping NULLs and ranks outside of 1..UINT32_MAX
+void addRows(TrancoIndex::Builder &builder, DataChunk &chunk) {
+	UnifiedVectorFormat domains;
+	UnifiedVectorFormat ranks;
+	chunk.data[0].ToUnifiedFormat(chunk.size(), domains);
+	chunk.data[1].ToUnifiedFormat(chunk.size(), ranks);
+	auto domain_data = UnifiedVectorFormat::GetData<string_t>(domains);
+	auto rank_data = UnifiedVectorFormat::GetData<int64_t>(ranks);
+	for (idx_t i = 0; i < chunk.size(); ++i) {
+		auto domain_index = domains.sel->get_index(i);
+		auto rank_index = ranks.sel->get_index(i);
+		if (!domains.validity.RowIsValid(domain_index) || !ranks.validity.RowIsValid(rank_index)) {
+			continue;
+		}
+		auto rank = rank_data[rank_index];
+		if (rank <= 0 || rank > std::numeric_limits<uint32_t>::max()) {
+			continue;
+		}
+		auto &domain = domain_data[domain_index];
+		builder.add(std::string_view(domain.GetData(), domain.GetSize()), static_cast<uint32_t>(rank));
+	}
+}
+
+// Finalizer of MurmurHash3
+uint64_t mix(uint64_t hash) {
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+	hash *= 0xc4ceb9fe1a85ec53ULL;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+// Indexes of every list in use anywhere in the process. The entries don't keep an index alive, the databases and
+// queries that use it do.
+std::mutex shared_indexes_lock;
+std::map<std::pair<std::string, uint64_t>, std::weak_ptr<const TrancoIndex>> shared_indexes;
+
+std::map<std::pair<std::string, uint64_t>, std::weak_ptr<const TrancoIndex>> &sharedIndexes() {
+	return shared_indexes;
+}
+
+// Snapshot path named by the comment of `table`, empty if there is none
+std::string snapshotPath(TableCatalogEntry &table) {
+	if (table.comment.IsNull() || table.comment.type().id() != LogicalTypeId::VARCHAR) {
+		return "";
+	}
+	auto comment = table.comment.GetValue<std::string>();
+	std::string prefix = TrancoIndex::SNAPSHOT_COMMENT_PREFIX;
+	if (comment.compare(0, prefix.size(), prefix) != 0) {
+		return "";
+	}
+	return comment.substr(prefix.size());
+}
+} // namespace
+
+std::shared_ptr<const TrancoIndex> TrancoIndex::load(Connection &con, const std::string &table_name,
+                                                     const std::string &list_date) {
+	LogMessage(LogLevel::LOG_INFO, "Building Tranco index");
+
+	auto result = con.Query("SELECT domain::VARCHAR, rank::BIGINT FROM " + table_name);
+	if (result->HasError()) {
+		LogMessage(LogLevel::LOG_CRITICAL, result->GetError());
+	}
+
+	Builder builder;
+	while (auto chunk = result->Fetch()) {
+		addRows(builder, *chunk);
+	}
+	return builder.build(list_date);
+}
+
+std::shared_ptr<const TrancoIndex> TrancoIndex::load(ClientContext &context, TableCatalogEntry &table,
+                                                     const std::string &list_date) {
+	LogMessage(LogLevel::LOG_INFO, "Building Tranco index");
+
+	Builder builder;
+	ScanTable(context, table, {"domain", "rank"}, {LogicalType::VARCHAR, LogicalType::BIGINT},
+	          [&](DataChunk &chunk) { addRows(builder, chunk); });
+	return builder.build(list_date);
+}
+
+void TrancoIndex::Builder::add(std::string_view domain, uint32_t rank) {
+	if (domain.empty() || domain.size() > MAX_DOMAIN_LENGTH || rank == 0) {
+		return;
+	}
+	entries.emplace_back(static_cast<uint32_t>(arena.size()), rank);
+	arena += static_cast<char>(domain.size());
+	for (char c : domain) {
+		arena += toLowerASCII(c);
+	}
+}
+
+std::shared_ptr<const TrancoIndex> TrancoIndex::Builder::build(const std::string &list_date) {
+	auto index = std::make_shared<TrancoIndex>();
+	index->list_date = list_date;
+
+	// Keep the load factor at or below 0.7, misses stop after a few probes
+	size_t slot_count = 16;
+	while (slot_count * 7 < entries.size() * 10) {
+		slot_count *= 2;
+	}
+	index->slot_storage.assign(slot_count, Slot {0, 0, 0});
+	index->arena_storage = std::move(arena);
+	index->slots = index->slot_storage.data();
+	index->arena = index->arena_storage.data();
+	index->slot_mask = slot_count - 1;
+	index->arena_size = index->arena_storage.size();
+
+	for (auto &entry : entries) {
+		std::string_view domain(index->arena + entry.first + 1, static_cast<unsigned char>(index->arena[entry.first]));
+		uint64_t domain_hash = hash(domain);
+		auto tag = static_cast<uint32_t>(domain_hash >> 32);
+		for (size_t i = domain_hash & index->slot_mask;; i = (i + 1) & index->slot_mask) {
+			auto &slot = index->slot_storage[i];
+			if (slot.rank == 0) {
+				slot = Slot {tag, entry.first, entry.second};
+				++index->domain_count;
+				break;
+			}
+			if (slot.tag == tag && index->matches(slot, domain)) {
+				slot.rank = std::min(slot.rank, entry.second);
+				break;
+			}
+		}
+	}
+
+	// Only the first copy of duplicate domains is referenced, the others stay in the arena
+	entries.clear();
+	arena.clear();
+
+	// The domains of a bucket are a prefix of the domains sorted by rank
+	uint32_t last_filtered_rank = BUCKET_ENDS[FILTERED_CATEGORIES - 1];
+	std::vector<std::pair<uint32_t, uint64_t>> ranked;
+	for (auto &slot : index->slot_storage) {
+		if (slot.rank == 0) {
+			continue;
+		}
+		auto length = static_cast<unsigned char>(index->arena[slot.offset]);
+		uint64_t domain_hash = hash(std::string_view(index->arena + slot.offset + 1, length));
+		// A sum does not depend on the order of the slots, which depends on the order the domains were added in
+		index->list_checksum += mix(domain_hash ^ (slot.rank * 0x9e3779b97f4a7c15ULL));
+		if (slot.rank <= last_filtered_rank) {
+			ranked.emplace_back(slot.rank, domain_hash);
+		}
+	}
+	std::sort(ranked.begin(), ranked.end());
+	std::vector<uint64_t> keys;
+	size_t ranked_count = 0;
+	for (idx_t bucket = 0; bucket < FILTERED_CATEGORIES; ++bucket) {
+		while (ranked_count < ranked.size() && ranked[ranked_count].first <= BUCKET_ENDS[bucket]) {
+			keys.push_back(ranked[ranked_count++].second);
+		}
+		// build() reorders the keys, which doesn't matter for the larger buckets that add to them
+		index->filters.push_back(BinaryFuseFilter::build(keys));
+	}
+	return index;
+}
+
+uint64_t TrancoIndex::hash(std::string_view domain) {
+	// FNV-1a over the lower-case bytes. Its low bits are weak for keys sharing a suffix (".com"), and linear probing
+	// turns that into long clusters, so the result is mixed once more before it picks a slot.
+	uint64_t hash = 14695981039346656037ULL;
+	for (char c : domain) {
+		hash ^= static_cast<unsigned char>(toLowerASCII(c));
+		hash *= 1099511628211ULL;
+	}
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+void TrancoIndex::prefetch(uint64_t hash) const {
+#if defined(__GNUC__) || defined(__clang__)
+	if (slots) {
+		__builtin_prefetch(&slots[hash & slot_mask]);
+	}
+#endif
+}
+
+bool TrancoIndex::matches(const Slot &slot, std::string_view domain) const {
+	// Offsets of a snapshot come from disk, a damaged file must not send a lookup outside the arena
+	if (slot.offset + 1 + domain.size() > arena_size) {
+		return false;
+	}
+	const char *stored = arena + slot.offset;
+	if (static_cast<unsigned char>(stored[0]) != domain.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < domain.size(); ++i) {
+		if (stored[i + 1] != toLowerASCII(domain[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+uint32_t TrancoIndex::rank(std::string_view domain, uint64_t hash) const {
+	if (!slots || domain.empty() || domain.size() > MAX_DOMAIN_LENGTH) {
+		return 0;
+	}
+	auto tag = static_cast<uint32_t>(hash >> 32);
+	// Stop after a full round too, in case a damaged snapshot has no empty slot left
+	size_t i = hash & slot_mask;
+	for (size_t probes = 0; probes <= slot_mask; ++probes, i = (i + 1) & slot_mask) {
+		auto &slot = slots[i];
+		if (slot.rank == 0) {
+			return 0;
+		}
+		if (slot.tag == tag && matches(slot, domain)) {
+			return slot.rank;
+		}
+	}
+	return 0;
+}
+
+bool TrancoIndex::inTop(std::string_view domain, uint64_t hash, uint32_t max_rank) const {
+	if (max_rank == 0) {
+		return false;
+	}
+	// Every domain ranked `max_rank` or better is in the filter of the smallest bucket that covers `max_rank`, and
+	// the filter rejects all but 1/256 of the others. Only what it finds is confirmed in the slots.
+	for (idx_t bucket = 0; bucket < filters.size(); ++bucket) {
+		if (BUCKET_ENDS[bucket] >= max_rank) {
+			if (!filters[bucket].contains(hash)) {
+				return false;
+			}
+			break;
+		}
+	}
+	auto listed_rank = rank(domain, hash);
+	return listed_rank != 0 && listed_rank <= max_rank;
+}
+
+bool TrancoIndex::save(const std::string &path) const {
+	SnapshotHeader header;
+	std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+	header.version = SNAPSHOT_VERSION;
+	header.byte_order = SNAPSHOT_BYTE_ORDER;
+	header.slot_count = slot_mask + 1;
+	header.domain_count = domain_count;
+	header.arena_size = arena_size;
+	std::memset(header.list_date, 0, sizeof(header.list_date));
+	std::memcpy(header.list_date, list_date.data(), std::min(list_date.size(), sizeof(header.list_date) - 1));
+	header.checksum = list_checksum;
+	header.filter_count = filters.size();
+	header.fingerprint_size = 0;
+	for (auto &filter : filters) {
+		header.fingerprint_size += filter.size();
+	}
+
+	// Processes that mapped the previous snapshot keep reading it, the new one only replaces its name. Databases of
+	// the process may save the same list at once, each writes its own temporary file.
+	auto temp_path = path + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+	{
+		std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char *>(slots),
+		           static_cast<std::streamsize>(header.slot_count * sizeof(Slot)));
+		for (auto &filter : filters) {
+			file.write(reinterpret_cast<const char *>(&filter.layout()), sizeof(BinaryFuseFilter::Layout));
+		}
+		for (auto &filter : filters) {
+			file.write(reinterpret_cast<const char *>(filter.data()), static_cast<std::streamsize>(filter.size()));
+		}
+		file.write(arena, static_cast<std::streamsize>(arena_size));
+		if (!file.good()) {
+			file.close();
+			std::remove(temp_path.c_str());
+			return false;
+		}
+	}
+#ifdef _WIN32
+	std::remove(path.c_str());
+#endif
+	if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+		std::remove(temp_path.c_str());
+		return false;
+	}
+	return true;
+}
+
+std::shared_ptr<const TrancoIndex> TrancoIndex::open(const std::string &path) {
+	auto mapping = MappedFile::open(path);
+	if (!mapping || mapping->size() < sizeof(SnapshotHeader)) {
+		return nullptr;
+	}
+
+	SnapshotHeader header;
+	std::memcpy(&header, mapping->data(), sizeof(header));
+	if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 || header.version != SNAPSHOT_VERSION ||
+	    header.byte_order != SNAPSHOT_BYTE_ORDER) {
+		return nullptr;
+	}
+	// Only the sizes are checked, the slots are left untouched until a lookup needs them
+	auto slots_size = header.slot_count * sizeof(Slot);
+	if (header.slot_count == 0 || (header.slot_count & (header.slot_count - 1)) != 0 ||
+	    header.slot_count > mapping->size() || header.arena_size > mapping->size() ||
+	    header.filter_count > FILTERED_CATEGORIES || header.fingerprint_size > mapping->size()) {
+		return nullptr;
+	}
+	// The builder keeps the load factor at or below 0.7, which leaves empty slots that end the probes of a miss
+	if (header.domain_count > header.slot_count || header.domain_count * 10 > header.slot_count * 7) {
+		return nullptr;
+	}
+	auto filters_size = header.filter_count * sizeof(BinaryFuseFilter::Layout) + header.fingerprint_size;
+	if (sizeof(header) + slots_size + filters_size + header.arena_size != mapping->size()) {
+		return nullptr;
+	}
+
+	auto index = std::make_shared<TrancoIndex>();
+	auto layouts = mapping->data() + sizeof(header) + slots_size;
+	auto fingerprints = layouts + header.filter_count * sizeof(BinaryFuseFilter::Layout);
+	size_t fingerprints_left = header.fingerprint_size;
+	index->filters.resize(header.filter_count);
+	for (auto &filter : index->filters) {
+		BinaryFuseFilter::Layout layout;
+		std::memcpy(&layout, layouts, sizeof(layout));
+		layouts += sizeof(layout);
+		if (layout.array_length > fingerprints_left ||
+		    !filter.view(layout, reinterpret_cast<const uint8_t *>(fingerprints), layout.array_length)) {
+			return nullptr;
+		}
+		fingerprints += layout.array_length;
+		fingerprints_left -= layout.array_length;
+	}
+	if (fingerprints_left != 0) {
+		return nullptr;
+	}
+	index->slots = reinterpret_cast<const Slot *>(mapping->data() + sizeof(header));
+	index->arena = mapping->data() + sizeof(header) + slots_size + filters_size;
+	index->slot_mask = header.slot_count - 1;
+	index->arena_size = header.arena_size;
+	index->domain_count = header.domain_count;
+	index->list_date = std::string(header.list_date, strnlen(header.list_date, sizeof(header.list_date)));
+	index->list_checksum = header.checksum;
+	index->mapping = std::move(mapping);
+	return index;
+}
+
+const char *const TrancoIndex::CATEGORIES[CATEGORY_COUNT] = {"top1k",   "top5k",   "top10k", "top50k", "top100k",
+                                                              "top500k", "top1m", "top5m",  "other"};
+
+uint8_t TrancoIndex::category(uint32_t rank) {
+	uint8_t bucket = 0;
+	while (bucket < sizeof(BUCKET_ENDS) / sizeof(BUCKET_ENDS[0]) && rank > BUCKET_ENDS[bucket]) {
+		++bucket;
+	}
+	return bucket;
+}
+
+std::shared_ptr<const TrancoIndex> TrancoIndex::forTable(ClientContext &context) {
+	auto table = Catalog::GetEntry<TableCatalogEntry>(context, INVALID_CATALOG, INVALID_SCHEMA, "tranco_list",
+	                                                  OnEntryNotFound::RETURN_NULL);
+	if (!table) {
+		return nullptr;
+	}
+
+	// Any statement can change the rows, so every query reads them again as its transaction sees them
+	auto snapshot = snapshotPath(*table);
+	if (snapshot.empty()) {
+		return queryIndex(context, *table);
+	}
+
+	// The path comes from a table comment, so it is only mapped where DuckDB may read files
+	if (!DBConfig::GetConfig(context).CanAccessFile(snapshot, FileType::FILE_TYPE_REGULAR)) {
+		LogMessage(LogLevel::LOG_WARNING, "Tranco snapshot `" + snapshot + "` can't be accessed, reading the table");
+		return queryIndex(context, *table);
+	}
+	auto &db = *context.db;
+	if (auto published = publishedIndex(db, *table, snapshot)) {
+		return published;
+	}
+	// Queries on other catalogs and those still pinning the previous index carry on while this one is opened
+	auto index = open(snapshot);
+	if (!index) {
+		LogMessage(LogLevel::LOG_WARNING, "Tranco snapshot `" + snapshot + "` can't be used, reading the table");
+		return queryIndex(context, *table);
+	}
+	index = share(std::move(index));
+	// A table created or commented by a running transaction may still be rolled back
+	if (table->timestamp < TRANSACTION_ID_START) {
+		publishIndex(db, *table, snapshot, index);
+	}
+	return index;
+}
+
+void TrancoIndex::publish(ClientContext &context, std::shared_ptr<const TrancoIndex> index,
+                          const std::string &snapshot) {
+	auto table = Catalog::GetEntry<TableCatalogEntry>(context, INVALID_CATALOG, INVALID_SCHEMA, "tranco_list",
+	                                                  OnEntryNotFound::RETURN_NULL);
+	// The table may have been replaced again in the meantime, and one without a snapshot is read by every query
+	if (!table || snapshot.empty() || snapshotPath(*table) != snapshot) {
+		return;
+	}
+	publishIndex(*context.db, *table, snapshot, share(std::move(index)));
+}
+
+size_t TrancoIndex::sharedBy(const TrancoIndex &index) {
+	std::lock_guard<std::mutex> guard(table_indexes_lock);
+	size_t catalogs = 0;
+	for (auto &entry : tableIndexes()) {
+		if (entry.second.index.get() == &index && !entry.second.database.expired()) {
+			++catalogs;
+		}
+	}
+	return catalogs;
+}
+
+std::shared_ptr<const TrancoIndex> TrancoIndex::share(std::shared_ptr<const TrancoIndex> index) {
+	if (!index || index->list_date.empty()) {
+		return index;
+	}
+	std::lock_guard<std::mutex> guard(shared_indexes_lock);
+	auto &indexes = sharedIndexes();
+	auto &entry = indexes[{index->list_date, index->list_checksum}];
+	if (auto existing = entry.lock()) {
+		return existing;
+	}
+	entry = index;
+	// Forget the lists nobody uses anymore
+	for (auto it = indexes.begin(); it != indexes.end();) {
+		it = it->second.expired() ? indexes.erase(it) : std::next(it);
+	}
+	return index;
+}
+
+unique_ptr<FunctionLocalState> TrancoIndexLocalState::Init(ExpressionState &state, const BoundFunctionExpression &,
+                                                           FunctionData *bind_data) {
+	auto index = TrancoIndex::forTable(state.GetContext());
+	if (!index) {
+		LogMessage(LogLevel::LOG_CRITICAL,
+		           "Tranco table not found. Download it first using `SELECT update_tranco(true);`");
+	}
+	auto local_state = make_uniq<TrancoIndexLocalState>(std::move(index));
+	if (bind_data && bind_data->Cast<TrancoLookupData>().suffix_walk) {
+		local_state->domain_cache = make_uniq<DomainCache>(DomainCache::configuredCapacity(state.GetContext()));
+	}
+	return std::move(local_state);
+}
+
+TrancoIndexLocalState &TrancoIndexLocalState::Get(ExpressionState &state) {
+	return ExecuteFunctionState::GetFunctionState(state)->Cast<TrancoIndexLocalState>();
+}
+} // namespace duckdb::netquack
@@ -0,0 +1,162 @@
+// Copyright 2026 Arash Hatami
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "domain_cache.hpp"
+#include "duckdb.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "fuse_filter.hpp"
+#include "mapped_file.hpp"
+
+namespace duckdb::netquack {
+// Read-only domain -> rank map of one Tranco list, shared by all threads and queries.
+// Domains are interned in one arena as <length byte><lower-case bytes>. The table is open addressing with linear
+// probing over 12-byte slots, lookups fold ASCII case on the fly and never allocate.
+// Every rank bucket up to top1m also has a binary fuse filter of the domains ranked within it, which answers most
+// "is it in the top N" questions about unlisted domains without touching the slots.
+// A snapshot file is a header followed by the slots, the filters and the arena exactly as they are laid out in
+// memory, so an index opened from one is used in place and only the pages that lookups touch are ever read.
+class TrancoIndex {
+public:
+	// Longest domain that is indexed, longer entries are not valid DNS names
+	static constexpr size_t MAX_DOMAIN_LENGTH = 253;
+
+	// Collects (domain, rank) pairs, the lowest rank of a duplicate domain wins
+	class Builder {
+	public:
+		void add(std::string_view domain, uint32_t rank);
+		// `list_date` is the date of the Tranco list ("YYYY-MM-DD"), empty if it is not known
+		std::shared_ptr<const TrancoIndex> build(const std::string &list_date = "");
+
+	private:
+		std::string arena;
+		// (arena offset, rank) of every added domain
+		std::vector<std::pair<uint32_t, uint32_t>> entries;
+	};
+
+	// Hash of `domain` as used by the table, case-insensitive
+	static uint64_t hash(std::string_view domain);
+	// Load the slot `hash` starts probing at into the cache
+	void prefetch(uint64_t hash) const;
+	// Rank of `domain`, 0 if it is not in the list. `hash` must be hash(domain).
+	uint32_t rank(std::string_view domain, uint64_t hash) const;
+	uint32_t rank(std::string_view domain) const {
+		return rank(domain, hash(domain));
+	}
+	// True if `domain` is ranked `max_rank` or better. `hash` must be hash(domain).
+	bool inTop(std::string_view domain, uint64_t hash, uint32_t max_rank) const;
+
+	size_t size() const {
+		return domain_count;
+	}
+	// Date of the Tranco list, empty for lists loaded from a table of unknown origin
+	const std::string &date() const {
+		return list_date;
+	}
+	// True if the index is a mapped snapshot rather than built in memory
+	bool mapped() const {
+		return mapping != nullptr;
+	}
+	// Order-independent hash of the (domain, rank) pairs, tells lists of the same date apart
+	uint64_t checksum() const {
+		return list_checksum;
+	}
+
+	// The index of the same list if another database of the process uses one already, `index` otherwise. Indexes
+	// are shared by list date and checksum and released with their last user. Lists of unknown date are not shared.
+	static std::shared_ptr<const TrancoIndex> share(std::shared_ptr<const TrancoIndex> index);
+	// Number of catalogs, in any open database of the process, whose `tranco_list` is served from `index`
+	static size_t sharedBy(const TrancoIndex &index);
+
+	// Write the index to `path` as a snapshot, replacing the file atomically. Returns false on failure.
+	bool save(const std::string &path) const;
+	// Map the snapshot at `path`, nullptr if it is missing or not a valid snapshot
+	static std::shared_ptr<const TrancoIndex> open(const std::string &path);
+
+	// Rank buckets from the best to the worst ranks: "top1k" ... "top5m", then "other"
+	static constexpr idx_t CATEGORY_COUNT = 9;
+	static const char *const CATEGORIES[CATEGORY_COUNT];
+	// Position of the bucket of `rank` in CATEGORIES
+	static uint8_t category(uint32_t rank);
+	// Buckets with a membership filter, "top1k" to "top1m". The larger ones hold most of the list.
+	static constexpr idx_t FILTERED_CATEGORIES = 7;
+
+	// Index of the `tranco_list` table visible to `context`, nullptr if there is no such table.
+	// A table whose comment names a snapshot (SNAPSHOT_COMMENT_PREFIX followed by the path), as the tables loaded by
+	// update_tranco do, maps that file instead of reading its rows. The snapshot is opened once per database and
+	// table. Any other table is read again by every query, as the transaction of the query sees it.
+	static std::shared_ptr<const TrancoIndex> forTable(ClientContext &context);
+	// Build an index from the `domain` and `rank` columns of `table_name`, read through `con`
+	static std::shared_ptr<const TrancoIndex> load(Connection &con, const std::string &table_name,
+	                                               const std::string &list_date);
+	// Build an index from the `domain` and `rank` columns of `table` as the transaction of `context` sees them
+	static std::shared_ptr<const TrancoIndex> load(ClientContext &context, TableCatalogEntry &table,
+	                                               const std::string &list_date);
+	// Make `index` the index of the `tranco_list` table visible to `context`, if the table still names `snapshot`
+	// in its comment. Queries that already started keep the index they pinned.
+	static void publish(ClientContext &context, std::shared_ptr<const TrancoIndex> index, const std::string &snapshot);
+	static constexpr const char *SNAPSHOT_COMMENT_PREFIX = "netquack tranco snapshot: ";
+
+private:
+	struct Slot {
+		uint32_t tag;    // upper half of the hash
+		uint32_t offset; // of the domain in the arena
+		uint32_t rank;   // 0 for an empty slot
+	};
+
+	bool matches(const Slot &slot, std::string_view domain) const;
+
+	// Point to either the owned storage of a built index or into the mapping of a snapshot
+	const Slot *slots = nullptr;
+	const char *arena = nullptr;
+	size_t slot_mask = 0;
+	size_t arena_size = 0;
+	size_t domain_count = 0;
+	std::string list_date;
+	uint64_t list_checksum = 0;
+
+	// Filter of the domains ranked within CATEGORIES[i] or better, for each filtered bucket
+	std::vector<BinaryFuseFilter> filters;
+
+	std::vector<Slot> slot_storage;
+	std::string arena_storage;
+	std::unique_ptr<MappedFile> mapping;
+};
+
+// Bind data of the Tranco lookup functions
+struct TrancoLookupData : public FunctionData {
+	explicit TrancoLookupData(bool suffix_walk) : suffix_walk(suffix_walk) {
+	}
+
+	// Look up the host of a URL, then its parent domains down to the registrable domain until one is listed
+	bool suffix_walk;
+
+	unique_ptr<FunctionData> Copy() const override {
+		return make_uniq<TrancoLookupData>(suffix_walk);
+	}
+	bool Equals(const FunctionData &other) const override {
+		return suffix_walk == other.Cast<TrancoLookupData>().suffix_walk;
+	}
+};
+
+// Function local state of the Tranco lookup functions, pins one index for the whole query
+struct TrancoIndexLocalState : public FunctionLocalState {
+	explicit TrancoIndexLocalState(std::shared_ptr<const TrancoIndex> index) : index(std::move(index)) {
+	}
+
+	std::shared_ptr<const TrancoIndex> index;
+	// Finds the registrable domain that ends a suffix walk, nullptr for exact lookups
+	unique_ptr<DomainCache> domain_cache;
+
+	// Fails when there is no `tranco_list` table
+	static unique_ptr<FunctionLocalState> Init(ExpressionState &state, const BoundFunctionExpression &expr,
+	                                           FunctionData *bind_data);
+	static TrancoIndexLocalState &Get(ExpressionState &state);
+};
+} // namespace duckdb::netquack
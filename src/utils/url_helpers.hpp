@@ -5,6 +5,8 @@
 #include <cstring>
 #include <string_view>
 
+#include "find_symbols.hpp"
+
 namespace duckdb::netquack {
 using Pos = const char *;
 
@@ -20,34 +22,37 @@ constexpr bool isNumericASCII(char c) noexcept {
 	return (c >= '0' && c <= '9');
 }
 
-template <char symbol>
-inline Pos find_first_symbols(Pos begin, Pos end) noexcept {
-	for (Pos pos = begin; pos < end; ++pos) {
-		if (*pos == symbol) {
-			return pos;
+constexpr bool isUpperASCII(char c) noexcept {
+	return (c >= 'A' && c <= 'Z');
+}
+
+constexpr char toLowerASCII(char c) noexcept {
+	return isUpperASCII(c) ? static_cast<char>(c + ('a' - 'A')) : c;
+}
+
+// Check if `data` starts with `prefix`, ignoring ASCII case (`prefix` must be lower-case)
+inline bool startsWithLowerCase(std::string_view data, std::string_view prefix) noexcept {
+	if (data.size() < prefix.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < prefix.size(); ++i) {
+		if (toLowerASCII(data[i]) != prefix[i]) {
+			return false;
 		}
 	}
-	return end;
+	return true;
 }
 
-template <char symbol1, char symbol2>
+// Find the first occurrence of any of `symbols` in [begin, end), or `end`
+template <char... symbols>
 inline Pos find_first_symbols(Pos begin, Pos end) noexcept {
-	for (Pos pos = begin; pos < end; ++pos) {
-		if (*pos == symbol1 || *pos == symbol2) {
-			return pos;
-		}
-	}
-	return end;
+	return simd::findFirst<symbols...>(begin, end);
 }
 
-template <char symbol>
+// Find the last occurrence of any of `symbols` in [begin, end), or nullptr
+template <char... symbols>
 inline Pos find_last_symbols_or_null(Pos begin, Pos end) noexcept {
-	for (Pos pos = end - 1; pos >= begin; --pos) {
-		if (*pos == symbol) {
-			return pos;
-		}
-	}
-	return nullptr;
+	return simd::findLast<symbols...>(begin, end);
 }
 
 inline std::string_view getURLScheme(const char *data, size_t size) {
@@ -127,61 +132,168 @@ inline std::string_view getURLHost(const char *data, size_t size) {
 		}
 	}
 
-	Pos dot_pos = nullptr;
+	// Jump between the symbols that end or restart the host. Dots are not tracked in the scan,
+	// the last one before the end of the host is looked up once the end is known.
 	const auto *start_of_host = pos;
-	for (; pos < end; ++pos) {
+	for (; (pos = find_first_symbols<':', '/', '?', '#', '@', ' ', '\t', '<', '>', '%', '{', '}', '|', '\\', '^', '~',
+	                                 '[', ']', ';', '=', '&'>(pos, end)) < end;
+	     ++pos) {
 		switch (*pos) {
-		case '.':
-			dot_pos = pos;
-			break;
 		case ':':
 			// Check if this is userinfo (user:pass@host) or host:port
 			// Look ahead for @ to determine if we're in userinfo
 			{
-				Pos lookahead = pos + 1;
-				while (lookahead < end && *lookahead != '/' && *lookahead != '?' && *lookahead != '#') {
-					if (*lookahead == '@') {
-						// This colon is in userinfo, skip to after @
-						pos = lookahead;
-						start_of_host = lookahead + 1;
-						dot_pos = nullptr;
-						goto continue_loop;
-					}
-					++lookahead;
+				Pos lookahead = find_first_symbols<'@', '/', '?', '#'>(pos + 1, end);
+				if (lookahead < end && *lookahead == '@') {
+					// This colon is in userinfo, skip to after @
+					pos = lookahead;
+					start_of_host = lookahead + 1;
+					continue;
 				}
 			}
 			// No @ found, this is host:port - return host
-			return checkAndReturnHost(pos, dot_pos, start_of_host);
+			return checkAndReturnHost(pos, find_last_symbols_or_null<'.'>(start_of_host, pos), start_of_host);
 		case '/':
 		case '?':
 		case '#':
-			return checkAndReturnHost(pos, dot_pos, start_of_host);
+			return checkAndReturnHost(pos, find_last_symbols_or_null<'.'>(start_of_host, pos), start_of_host);
 		case '@': // Handle user@host format (no password)
 			start_of_host = pos + 1;
-			dot_pos = nullptr; // Reset dot_pos since any previous dots were in userinfo
 			break;
-		case ' ': // restricted symbols in whole URL
-		case '\t':
-		case '<':
-		case '>':
-		case '%':
-		case '{':
-		case '}':
-		case '|':
-		case '\\':
-		case '^':
-		case '~':
-		case '[':
-		case ']':
-		case ';':
-		case '=':
-		case '&':
+		default: // restricted symbols in whole URL
 			return std::string_view {};
 		}
-	continue_loop:;
 	}
 
-	return checkAndReturnHost(pos, dot_pos, start_of_host);
+	return checkAndReturnHost(end, find_last_symbols_or_null<'.'>(start_of_host, end), start_of_host);
+}
+
+// Components of a URL as views into the original string. Missing components are empty.
+struct URLComponents {
+	std::string_view scheme;
+	std::string_view host;
+	std::string_view port;
+	std::string_view path;
+	std::string_view query;
+	std::string_view fragment;
+};
+
+inline bool isRestrictedHostSymbol(char c) noexcept {
+	switch (c) {
+	case ' ':
+	case '\t':
+	case '<':
+	case '>':
+	case '%':
+	case '{':
+	case '}':
+	case '|':
+	case '\\':
+	case '^':
+	case '~':
+	case '[':
+	case ']':
+	case ';':
+	case '=':
+	case '&':
+		return true;
+	default:
+		return false;
+	}
+}
+
+// Split a URL into its components in a single left-to-right scan.
+// Accepts `scheme://authority/path?query#fragment`, protocol-relative `//authority/...` and bare
+// `authority/...` inputs. The host follows the same rules as getURLHost (it needs a dot and may not
+// contain restricted symbols), except that bracketed IPv6 literals are returned without the brackets.
+inline URLComponents tokenizeURL(const char *data, size_t size) {
+	URLComponents url;
+	Pos pos = data;
+	Pos end = data + size;
+
+	// Scheme
+	if (size >= 2 && pos[0] == '/' && pos[1] == '/') {
+		pos += 2;
+	} else if (size > 0 && isAlphaASCII(*pos)) {
+		Pos scheme_end = pos + 1;
+		while (scheme_end < end && (isAlphaNumericASCII(*scheme_end) || *scheme_end == '+' || *scheme_end == '-' ||
+		                            *scheme_end == '.')) {
+			++scheme_end;
+		}
+		if (end - scheme_end >= 3 && scheme_end[0] == ':' && scheme_end[1] == '/' && scheme_end[2] == '/') {
+			url.scheme = std::string_view(data, scheme_end - data);
+			pos = scheme_end + 3;
+		}
+	}
+
+	// Authority: [userinfo@]host[:port], up to the first '/', '?' or '#'
+	Pos host_begin = pos;
+	Pos host_end = nullptr;
+	Pos port_begin = nullptr;
+	bool in_brackets = false;
+	bool restricted = false;
+	for (; pos < end; ++pos) {
+		char c = *pos;
+		if (c == '/' || c == '?' || c == '#') {
+			break;
+		}
+		if (c == '@') {
+			// Everything so far was userinfo
+			host_begin = pos + 1;
+			host_end = nullptr;
+			port_begin = nullptr;
+			restricted = false;
+		} else if (c == '[' && pos == host_begin) {
+			in_brackets = true;
+		} else if (c == ']' && in_brackets) {
+			in_brackets = false;
+		} else if (c == ':' && !in_brackets && !host_end) {
+			host_end = pos;
+			port_begin = pos + 1;
+		} else if (!host_end && !in_brackets && isRestrictedHostSymbol(c)) {
+			restricted = true;
+		}
+	}
+	Pos authority_end = pos;
+	if (!host_end) {
+		host_end = authority_end;
+	}
+
+	std::string_view host(host_begin, host_end - host_begin);
+	if (host.size() > 2 && host.front() == '[' && host.back() == ']') {
+		url.host = host.substr(1, host.size() - 2);
+	} else if (!restricted && host.size() > 1 && host.back() != '.' && host.find('.') != std::string_view::npos) {
+		url.host = host;
+	}
+
+	if (port_begin && port_begin < authority_end) {
+		std::string_view port(port_begin, authority_end - port_begin);
+		bool numeric = true;
+		for (char c : port) {
+			numeric &= isNumericASCII(c);
+		}
+		if (numeric) {
+			url.port = port;
+		}
+	}
+
+	// Path, query and fragment
+	Pos path_begin = pos;
+	pos = find_first_symbols<'?', '#'>(pos, end);
+	url.path = std::string_view(path_begin, pos - path_begin);
+
+	if (pos < end && *pos == '?') {
+		Pos query_begin = ++pos;
+		pos = find_first_symbols<'#'>(pos, end);
+		url.query = std::string_view(query_begin, pos - query_begin);
+	}
+
+	if (pos < end && *pos == '#') {
+		++pos;
+		url.fragment = std::string_view(pos, end - pos);
+	}
+
+	return url;
 }
 
 } // namespace duckdb::netquack
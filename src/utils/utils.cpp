@@ -11,6 +11,7 @@
 #endif
 
 #include "logger.hpp"
+#include "tranco_csv.hpp"
 
 namespace duckdb::netquack {
 bool file_exists(const char *file_path) {
@@ -23,6 +24,17 @@ bool file_exists(const char *file_path) {
 #endif
 }
 
+std::string QuoteIdentifier(const std::string &name) {
+	std::string quoted = "\"";
+	for (char c : name) {
+		quoted += c;
+		if (c == '"') {
+			quoted += c;
+		}
+	}
+	return quoted + "\"";
+}
+
 CURL *CreateCurlHandler(curl_write_callback write_callback) {
 	CURL *curl = curl_easy_init();
 	if (!curl) {
@@ -76,4 +88,16 @@ size_t WriteFileCallback(char *contents, size_t size, size_t nmemb, void *userp)
 	FILE *file = (FILE *)userp;
 	return fwrite(contents, size, nmemb, file);
 }
+
+size_t WriteTrancoCsvCallback(char *contents, size_t size, size_t nmemb, void *userp) {
+	auto &parser = *static_cast<TrancoCsvParser *>(userp);
+	// Exceptions must not cross curl, a short count aborts the transfer and the caller raises the error
+	try {
+		parser.feed(contents, size * nmemb);
+	} catch (std::exception &ex) {
+		parser.error = ex.what();
+		return 0;
+	}
+	return size * nmemb;
+}
 } // namespace duckdb::netquack
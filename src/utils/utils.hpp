@@ -3,6 +3,8 @@
 #pragma once
 
 #include <curl/curl.h>
+#include <atomic>
+#include <memory>
 
 #include "duckdb/common/types/data_chunk.hpp"
 #include "duckdb/common/types/vector.hpp"
@@ -10,6 +12,9 @@
 #include "duckdb/main/database.hpp"
 
 namespace duckdb::netquack {
+// Quote `name` as an SQL identifier
+std::string QuoteIdentifier(const std::string &name);
+
 // Function to get a CURL handler with custom write callback
 CURL *CreateCurlHandler(curl_write_callback write_callback);
 
@@ -19,6 +24,21 @@ size_t WriteStringCallback(char *contents, size_t size, size_t nmemb, void *user
 // Function to write data to a file (for file downloads)
 size_t WriteFileCallback(char *contents, size_t size, size_t nmemb, void *userp);
 
+// Function to feed downloaded data to a TrancoCsvParser (for streamed Tranco lists)
+size_t WriteTrancoCsvCallback(char *contents, size_t size, size_t nmemb, void *userp);
+
+// How the Tranco list is fetched
+struct TrancoLoadOptions {
+	bool force = false;    // download the list even if it was downloaded before
+	bool stream = false;   // parse the download as it arrives instead of saving it as a CSV file first
+	bool history = false;  // add the list to the rank history
+	std::string list_url;  // download the list from here instead of tranco-list.eu, empty for the default
+	std::string list_date; // load the list of this day ("YYYY-MM-DD") instead of yesterday's, empty for yesterday
+	std::string list_path; // import the list from this local CSV file instead of downloading it, empty to download
+	// Stops a background refresh before its next step once set, nullptr for a refresh that can't be cancelled
+	const std::atomic_bool *cancelled = nullptr;
+};
+
 // Function to download the Tranco list and create a table
-void LoadTrancoList(DatabaseInstance &db, bool force);
+void LoadTrancoList(const std::weak_ptr<DatabaseInstance> &database, const TrancoLoadOptions &options);
 } // namespace duckdb::netquack
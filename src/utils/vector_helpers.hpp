@@ -0,0 +1,100 @@
+// Copyright 2026 Arash Hatami
+
+#pragma once
+
+#include <string_view>
+#include <type_traits>
+
+#include "duckdb.hpp"
+#include "parse_failures.hpp"
+#include "url_helpers.hpp"
+
+namespace duckdb::netquack {
+// Wrap a view into an input string as a result string without copying it.
+// Views of up to 12 bytes are inlined into the string_t. Longer views point into the input vector's
+// string heap, so the result vector must hold a reference to it (StringVector::AddHeapReference).
+inline string_t StringSlice(std::string_view slice) {
+	return string_t(slice.data(), static_cast<uint32_t>(slice.size()));
+}
+
+// Same as StringSlice, but folds ASCII letters to lower case.
+// The view is only copied into the result heap when it actually contains an upper-case letter.
+inline string_t LowerStringSlice(Vector &result, std::string_view slice) {
+	size_t first_upper = 0;
+	while (first_upper < slice.size() && !isUpperASCII(slice[first_upper])) {
+		++first_upper;
+	}
+	if (first_upper == slice.size()) {
+		return StringSlice(slice);
+	}
+
+	auto target = StringVector::EmptyString(result, slice.size());
+	auto target_data = target.GetDataWriteable();
+	memcpy(target_data, slice.data(), first_upper);
+	simd::toLower(slice.data() + first_upper, slice.data() + slice.size(), target_data + first_upper);
+	target.Finalize();
+	return target;
+}
+
+// Run `execute(source, target, count)` over the distinct values of `input` where that is no more work.
+// Dictionary inputs (e.g. dictionary-compressed URL columns) with fewer entries than the chunk has rows are
+// evaluated over the whole dictionary, including entries no row refers to, and the result is emitted as a
+// dictionary over the same selection. The size check keeps this from ever evaluating more values than the rows
+// would, but it only saves work when the rows repeat values. Constant and flat inputs are left to the executor,
+// which already handles constants in a single evaluation.
+// The `failures` of a dictionary input are counted per row, as if every row had been evaluated.
+template <class EXECUTE>
+void ExecuteDistinct(Vector &input, Vector &result, idx_t count, EXECUTE &&execute,
+                     ParseFailures *failures = nullptr) {
+	if (input.GetVectorType() == VectorType::DICTIONARY_VECTOR) {
+		auto dictionary_size = DictionaryVector::DictionarySize(input);
+		if (dictionary_size.IsValid() && dictionary_size.GetIndex() < count) {
+			auto &dictionary = DictionaryVector::Child(input);
+			Vector dictionary_result(result.GetType(), dictionary_size.GetIndex());
+			if (failures) {
+				failures->recordEntries();
+			}
+			execute(dictionary, dictionary_result, dictionary_size.GetIndex());
+			if (failures) {
+				failures->countRows(DictionaryVector::SelVector(input), count, dictionary_size.GetIndex());
+			}
+			result.Dictionary(dictionary_result, dictionary_size.GetIndex(), DictionaryVector::SelVector(input), count);
+			return;
+		}
+	}
+	execute(input, result, count);
+}
+
+// UnaryExecutor::Execute with dictionary awareness.
+// `fun(value, target)` must add any non-inlined result strings to `target`, not to `result`.
+// For VARCHAR -> VARCHAR functions the target references the input strings, so results may be
+// slices of the input (see StringSlice).
+template <class INPUT_TYPE, class RESULT_TYPE, class FUNC>
+void ExecuteUnary(Vector &input, Vector &result, idx_t count, FUNC &&fun) {
+	ExecuteDistinct(input, result, count, [&](Vector &source, Vector &target, idx_t source_count) {
+		if constexpr (std::is_same_v<INPUT_TYPE, string_t> && std::is_same_v<RESULT_TYPE, string_t>) {
+			StringVector::AddHeapReference(target, source);
+		}
+		UnaryExecutor::Execute<INPUT_TYPE, RESULT_TYPE>(source, target, source_count,
+		                                                [&](INPUT_TYPE value) { return fun(value, target); });
+	});
+}
+
+// UnaryExecutor::ExecuteWithNulls with dictionary awareness, for functions that can return NULL.
+// `fun(value, mask, idx, target)` follows the same rules as in ExecuteUnary, and reports malformed values to
+// `failures` if it is given.
+template <class INPUT_TYPE, class RESULT_TYPE, class FUNC>
+void ExecuteUnaryWithNulls(Vector &input, Vector &result, idx_t count, FUNC &&fun, ParseFailures *failures = nullptr) {
+	ExecuteDistinct(
+	    input, result, count,
+	    [&](Vector &source, Vector &target, idx_t source_count) {
+		    if constexpr (std::is_same_v<INPUT_TYPE, string_t> && std::is_same_v<RESULT_TYPE, string_t>) {
+			    StringVector::AddHeapReference(target, source);
+		    }
+		    UnaryExecutor::ExecuteWithNulls<INPUT_TYPE, RESULT_TYPE>(
+		        source, target, source_count,
+		        [&](INPUT_TYPE value, ValidityMask &mask, idx_t idx) { return fun(value, mask, idx, target); });
+	    },
+	    failures);
+}
+} // namespace duckdb::netquack
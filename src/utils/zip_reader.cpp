@@ -0,0 +1,210 @@
+// Copyright 2026 Arash Hatami
+
+#include "zip_reader.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "logger.hpp"
+#include "miniz.hpp"
+
+namespace duckdb::netquack {
+namespace {
+constexpr uint32_t LOCAL_HEADER_SIGNATURE = 0x04034B50;
+constexpr uint32_t CENTRAL_HEADER_SIGNATURE = 0x02014B50;
+constexpr uint32_t END_OF_DIRECTORY_SIGNATURE = 0x06054B50;
+constexpr idx_t LOCAL_HEADER_SIZE = 30;
+constexpr idx_t CENTRAL_HEADER_SIZE = 46;
+constexpr idx_t END_OF_DIRECTORY_SIZE = 22;
+constexpr idx_t MAX_COMMENT_SIZE = 0xFFFF;
+constexpr idx_t CHUNK_SIZE = 1 << 20;
+
+constexpr uint16_t FLAG_ENCRYPTED = 1;
+constexpr uint16_t METHOD_STORED = 0;
+constexpr uint16_t METHOD_DEFLATED = 8;
+
+// Zip fields are little-endian
+uint16_t read16(const uint8_t *data) {
+	return static_cast<uint16_t>(data[0] | (data[1] << 8));
+}
+
+uint32_t read32(const uint8_t *data) {
+	return read16(data) | (static_cast<uint32_t>(read16(data + 2)) << 16);
+}
+
+struct ZipEntry {
+	std::string name;
+	uint16_t flags;
+	uint16_t method;
+	uint32_t crc;
+	uint32_t compressed_size;
+	uint32_t size;
+	uint32_t header_offset;
+};
+
+// Ends the inflate stream however the read ends
+struct InflateStream {
+	duckdb_miniz::mz_stream stream;
+	bool initialized = false;
+
+	~InflateStream() {
+		if (initialized) {
+			duckdb_miniz::mz_inflateEnd(&stream);
+		}
+	}
+};
+
+[[noreturn]] void fail(const std::string &path, const std::string &problem) {
+	LogMessage(LogLevel::LOG_CRITICAL, "Zip archive `" + path + "` " + problem);
+	throw std::runtime_error(problem);
+}
+
+// The entries of the central directory that are files
+std::vector<ZipEntry> readDirectory(FileHandle &file, const std::string &path) {
+	auto file_size = file.GetFileSize();
+	// The end of central directory record is last, only the archive comment follows it
+	auto tail_size = std::min<idx_t>(file_size, END_OF_DIRECTORY_SIZE + MAX_COMMENT_SIZE);
+	std::vector<uint8_t> tail(tail_size);
+	file.Read(tail.data(), tail_size, file_size - tail_size);
+	const uint8_t *record = nullptr;
+	for (idx_t i = tail_size >= END_OF_DIRECTORY_SIZE ? tail_size - END_OF_DIRECTORY_SIZE + 1 : 0; i-- > 0;) {
+		if (read32(tail.data() + i) == END_OF_DIRECTORY_SIGNATURE) {
+			record = tail.data() + i;
+			break;
+		}
+	}
+	if (!record) {
+		fail(path, "has no central directory");
+	}
+	auto entry_count = read16(record + 10);
+	auto directory_size = read32(record + 12);
+	auto directory_offset = read32(record + 16);
+	if (entry_count == 0xFFFF || directory_size == 0xFFFFFFFF || directory_offset == 0xFFFFFFFF) {
+		fail(path, "is a zip64 archive, which is not supported");
+	}
+	if (static_cast<idx_t>(directory_offset) + directory_size > file_size) {
+		fail(path, "is damaged");
+	}
+
+	std::vector<uint8_t> directory(directory_size);
+	file.Read(directory.data(), directory_size, directory_offset);
+	std::vector<ZipEntry> entries;
+	idx_t position = 0;
+	for (uint16_t i = 0; i < entry_count; ++i) {
+		auto header = directory.data() + position;
+		if (directory_size - position < CENTRAL_HEADER_SIZE || read32(header) != CENTRAL_HEADER_SIGNATURE) {
+			fail(path, "is damaged");
+		}
+		idx_t name_size = read16(header + 28);
+		idx_t header_size = CENTRAL_HEADER_SIZE + name_size + read16(header + 30) + read16(header + 32);
+		if (directory_size - position < header_size) {
+			fail(path, "is damaged");
+		}
+		position += header_size;
+
+		std::string name(reinterpret_cast<const char *>(header + CENTRAL_HEADER_SIZE), name_size);
+		if (name.empty() || name.back() == '/' || name.rfind("__MACOSX/", 0) == 0) {
+			continue;
+		}
+		entries.push_back(ZipEntry {std::move(name), read16(header + 8), read16(header + 10), read32(header + 16),
+		                            read32(header + 20), read32(header + 24), read32(header + 42)});
+	}
+	return entries;
+}
+} // namespace
+
+bool IsZipArchive(FileSystem &fs, const std::string &path) {
+	auto file = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ);
+	uint8_t magic[4] = {0, 0, 0, 0};
+	if (file->GetFileSize() < sizeof(magic)) {
+		return false;
+	}
+	file->Read(magic, sizeof(magic), 0);
+	return read32(magic) == LOCAL_HEADER_SIGNATURE;
+}
+
+void ReadZipEntry(FileSystem &fs, const std::string &path,
+                  const std::function<void(const char *data, size_t size)> &consume) {
+	auto file = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ);
+	auto entries = readDirectory(*file, path);
+	if (entries.size() != 1) {
+		fail(path, "must hold exactly one file, it holds " + std::to_string(entries.size()));
+	}
+	auto &entry = entries[0];
+	if (entry.flags & FLAG_ENCRYPTED) {
+		fail(path, "is encrypted");
+	}
+	if (entry.method != METHOD_STORED && entry.method != METHOD_DEFLATED) {
+		fail(path, "uses compression method " + std::to_string(entry.method) + ", only deflate is supported");
+	}
+
+	// The local header repeats the name and has its own extra field, the data follows them
+	uint8_t header[LOCAL_HEADER_SIZE];
+	auto file_size = file->GetFileSize();
+	if (static_cast<idx_t>(entry.header_offset) + LOCAL_HEADER_SIZE > file_size) {
+		fail(path, "is damaged");
+	}
+	file->Read(header, LOCAL_HEADER_SIZE, entry.header_offset);
+	if (read32(header) != LOCAL_HEADER_SIGNATURE) {
+		fail(path, "is damaged");
+	}
+	idx_t location = entry.header_offset + LOCAL_HEADER_SIZE + read16(header + 26) + read16(header + 28);
+	if (location + entry.compressed_size > file_size) {
+		fail(path, "is truncated");
+	}
+
+	uint32_t crc = MZ_CRC32_INIT;
+	idx_t size = 0;
+	auto emit = [&](const uint8_t *data, size_t data_size) {
+		crc = static_cast<uint32_t>(duckdb_miniz::mz_crc32(crc, data, data_size));
+		size += data_size;
+		consume(reinterpret_cast<const char *>(data), data_size);
+	};
+
+	std::vector<uint8_t> input(CHUNK_SIZE);
+	idx_t remaining = entry.compressed_size;
+	if (entry.method == METHOD_STORED) {
+		while (remaining > 0) {
+			auto chunk_size = std::min(remaining, CHUNK_SIZE);
+			file->Read(input.data(), chunk_size, location);
+			location += chunk_size;
+			remaining -= chunk_size;
+			emit(input.data(), chunk_size);
+		}
+	} else {
+		InflateStream inflate;
+		std::memset(&inflate.stream, 0, sizeof(inflate.stream));
+		// Zip entries are raw deflate streams, without a zlib header
+		if (duckdb_miniz::mz_inflateInit2(&inflate.stream, -MZ_DEFAULT_WINDOW_BITS) != duckdb_miniz::MZ_OK) {
+			fail(path, "can't be inflated");
+		}
+		inflate.initialized = true;
+		std::vector<uint8_t> output(CHUNK_SIZE);
+		int status = duckdb_miniz::MZ_OK;
+		while (status != duckdb_miniz::MZ_STREAM_END) {
+			if (inflate.stream.avail_in == 0) {
+				if (remaining == 0) {
+					fail(path, "is truncated");
+				}
+				auto chunk_size = std::min(remaining, CHUNK_SIZE);
+				file->Read(input.data(), chunk_size, location);
+				location += chunk_size;
+				remaining -= chunk_size;
+				inflate.stream.next_in = input.data();
+				inflate.stream.avail_in = static_cast<unsigned int>(chunk_size);
+			}
+			inflate.stream.next_out = output.data();
+			inflate.stream.avail_out = static_cast<unsigned int>(output.size());
+			status = duckdb_miniz::mz_inflate(&inflate.stream, duckdb_miniz::MZ_NO_FLUSH);
+			if (status != duckdb_miniz::MZ_OK && status != duckdb_miniz::MZ_STREAM_END) {
+				fail(path, "is damaged");
+			}
+			emit(output.data(), output.size() - inflate.stream.avail_out);
+		}
+	}
+	if (size != entry.size || crc != entry.crc) {
+		fail(path, "is damaged, the checksum of `" + entry.name + "` doesn't match");
+	}
+}
+} // namespace duckdb::netquack
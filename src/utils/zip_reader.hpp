@@ -0,0 +1,21 @@
+// Copyright 2026 Arash Hatami
+
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include "duckdb.hpp"
+#include "duckdb/common/file_system.hpp"
+
+namespace duckdb::netquack {
+// Whether the file at `path` starts like a zip archive
+bool IsZipArchive(FileSystem &fs, const std::string &path);
+
+// Pass the contents of the only file in the zip archive at `path` to `consume`, one chunk at a time. Deflated files
+// are inflated while they are read with the miniz bundled in DuckDB. Directories and macOS resource forks don't
+// count as files. The contents are checked against their CRC-32 at the end, so `consume` may have seen damaged data
+// when this throws.
+void ReadZipEntry(FileSystem &fs, const std::string &path,
+                  const std::function<void(const char *data, size_t size)> &consume);
+} // namespace duckdb::netquack
@@ -0,0 +1,164 @@
+// Copyright 2026 Arash Hatami
+
+// Differential test of the SIMD kernels of src/utils/find_symbols.hpp against its scalar loops.
+// The header has no dependencies, so this builds without DuckDB:
+//   c++ -std=c++17 -O2 -o find_symbols_test test/cpp/find_symbols_test.cpp && ./find_symbols_test
+
+#include "../../src/utils/find_symbols.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace simd = duckdb::netquack::simd;
+
+namespace {
+// Register widths of the kernels, needles are planted around their multiples
+constexpr size_t CHUNK_SIZES[] = {16, 32};
+constexpr size_t MAX_SIZE = 160;
+constexpr size_t MAX_OFFSET = 32;
+constexpr int ROUNDS = 2000;
+
+size_t failures = 0;
+
+void check(bool ok, const char *kernel, const std::string &input, size_t offset) {
+	if (ok) {
+		return;
+	}
+	if (++failures <= 10) {
+		std::fprintf(stderr, "%s differs from the scalar loop at offset %zu on \"", kernel, offset);
+		for (unsigned char c : input) {
+			std::fprintf(stderr, c >= 0x20 && c < 0x7F ? "%c" : "\\x%02x", c);
+		}
+		std::fprintf(stderr, "\"\n");
+	}
+}
+
+template <char... symbols>
+void compareFind(const std::string &input, size_t offset) {
+	// Copy to an offset from an aligned buffer, so loads start at every alignment
+	std::vector<char> buffer(offset + input.size() + 1);
+	std::copy(input.begin(), input.end(), buffer.begin() + offset);
+	simd::Pos begin = buffer.data() + offset;
+	simd::Pos end = begin + input.size();
+
+	auto first = simd::findFirstScalar<symbols...>(begin, end);
+	auto last = simd::findLastScalar<symbols...>(begin, end);
+	check(simd::findFirst<symbols...>(begin, end) == first, "findFirst", input, offset);
+	check(simd::findLast<symbols...>(begin, end) == last, "findLast", input, offset);
+#ifdef NETQUACK_SIMD_SSE2
+	check(simd::findFirstSSE2<symbols...>(begin, end) == first, "findFirstSSE2", input, offset);
+	check(simd::findLastSSE2<symbols...>(begin, end) == last, "findLastSSE2", input, offset);
+#endif
+#ifdef NETQUACK_SIMD_AVX2
+	if (simd::hasAVX2()) {
+		check(simd::findFirstAVX2<symbols...>(begin, end) == first, "findFirstAVX2", input, offset);
+		check(simd::findLastAVX2<symbols...>(begin, end) == last, "findLastAVX2", input, offset);
+	}
+#endif
+#ifdef NETQUACK_SIMD_NEON
+	check(simd::findFirstNEON<symbols...>(begin, end) == first, "findFirstNEON", input, offset);
+	check(simd::findLastNEON<symbols...>(begin, end) == last, "findLastNEON", input, offset);
+#endif
+}
+
+void compareToLower(const std::string &input, size_t offset) {
+	std::vector<char> buffer(offset + input.size() + 1);
+	std::copy(input.begin(), input.end(), buffer.begin() + offset);
+	simd::Pos begin = buffer.data() + offset;
+	simd::Pos end = begin + input.size();
+
+	std::string expected(input.size(), '\0');
+	simd::toLowerScalar(begin, end, &expected[0]);
+	std::string lower(input.size(), '\0');
+	simd::toLower(begin, end, &lower[0]);
+	check(lower == expected, "toLower", input, offset);
+#ifdef NETQUACK_SIMD_SSE2
+	simd::toLowerSSE2(begin, end, &lower[0]);
+	check(lower == expected, "toLowerSSE2", input, offset);
+#endif
+#ifdef NETQUACK_SIMD_NEON
+	simd::toLowerNEON(begin, end, &lower[0]);
+	check(lower == expected, "toLowerNEON", input, offset);
+#endif
+	// In place, as LowerStringSlice never does but toLower allows
+	std::vector<char> in_place(buffer);
+	simd::toLower(in_place.data() + offset, in_place.data() + offset + input.size(), in_place.data() + offset);
+	check(std::string(in_place.data() + offset, input.size()) == expected, "toLower in place", input, offset);
+}
+
+void compare(const std::string &input, size_t offset) {
+	compareFind<'/'>(input, offset);
+	compareFind<':', '/', '?', '#'>(input, offset);
+	compareFind<'.'>(input, offset);
+	compareFind<'@', '\x80', '\xff'>(input, offset);
+	compareToLower(input, offset);
+}
+
+// Filler without needles, with letters of both cases and bytes >= 0x80 that are negative as signed chars
+char filler(std::mt19937 &random) {
+	static const char bytes[] = "abcxyzABCXYZ019-_%\x7f\x80\xc3\xa9\xfe";
+	return bytes[random() % (sizeof(bytes) - 1)];
+}
+
+char needle(std::mt19937 &random) {
+	static const char bytes[] = "/:?#.@\x80\xff";
+	return bytes[random() % (sizeof(bytes) - 1)];
+}
+} // namespace
+
+int main() {
+	std::mt19937 random(20261017);
+
+	for (size_t size = 0; size <= MAX_SIZE; ++size) {
+		std::string input(size, '\0');
+		for (auto &c : input) {
+			c = filler(random);
+		}
+		// Without needles every kernel runs to the end of its loop and through the tail
+		compare(input, size % MAX_OFFSET);
+
+		// One needle on each side of every chunk boundary, and in each of the tail bytes
+		std::vector<size_t> positions;
+		for (auto chunk : CHUNK_SIZES) {
+			for (size_t boundary = chunk; boundary <= size; boundary += chunk) {
+				positions.push_back(boundary - 1);
+				positions.push_back(boundary);
+			}
+			for (size_t tail = size - size % chunk; tail < size; ++tail) {
+				positions.push_back(tail);
+			}
+		}
+		for (size_t position : positions) {
+			if (position >= size) {
+				continue;
+			}
+			auto planted = input;
+			planted[position] = needle(random);
+			for (size_t offset = 0; offset < MAX_OFFSET; offset += 7) {
+				compare(planted, offset);
+			}
+		}
+	}
+
+	// Random inputs with a random number of needles at random places
+	for (int round = 0; round < ROUNDS; ++round) {
+		std::string input(random() % (MAX_SIZE + 1), '\0');
+		for (auto &c : input) {
+			c = filler(random);
+		}
+		for (auto needles = input.empty() ? 0 : random() % 4; needles > 0; --needles) {
+			input[random() % input.size()] = needle(random);
+		}
+		compare(input, random() % MAX_OFFSET);
+	}
+
+	if (failures) {
+		std::fprintf(stderr, "%zu mismatches\n", failures);
+		return EXIT_FAILURE;
+	}
+	std::printf("find_symbols kernels match the scalar loops\n");
+	return EXIT_SUCCESS;
+}